@@ -0,0 +1,637 @@
+/**
+ * @file bench.cpp
+ * @brief Banc d'essai du chargement du dictionnaire (flux, zone contiguë, projection mémoire, binaire),
+ * de la construction de son arbre des préfixes et de son automate minimal, et de la mémoire occupée par une partie et par plusieurs.
+ * Avec --micro, mesure les opérations du jeu une à une sur ./ods4.txt, avec une graine fixe,
+ * et affiche une ligne par opération : nom, nombre d'opérations, ns par opération, allocations par opération,
+ * séparés par des tabulations.
+ * Avec --pire, joue des coups de robot après chaque préfixe de zéro, une et deux lettres, contesté ou non,
+ * et affiche le temps moyen et le pire temps d'un coup : le code de sortie est 1 si un coup dépasse le seuil
+ *
+ * Compilation : g++ -O2 -std=c++17 -pthread dico.cpp table.cpp cases.cpp eytzinger.cpp dawg.cpp solveur.cpp hasard.cpp \
+ *               sortie.cpp registre.cpp statistiques.cpp montecarlo.cpp livre.cpp fonctions.cpp simulation.cpp bench.cpp -o bench
+ * Utilisation : bench [fichier de mots] [nombre de répétitions]
+ *               bench --micro [nombre de répétitions]
+ *               bench --pire [seuil d'un coup en microsecondes] [coups par préfixe]
+ */
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <string>
+#include <new>
+#include <atomic>
+
+#include <malloc.h>
+
+#include "dico.h"
+#include "dawg.h"
+#include "hasard.h"
+#include "cases.h"
+#include "eytzinger.h"
+#include "table.h"
+#include "fonctions.h"
+#include "simulation.h"
+#include "registre.h"
+
+#pragma warning(disable:4996)
+
+using namespace std;
+
+// Mémoire allouée par new et pas encore libérée, pour mesurer ce que garde chaque représentation.
+// Le registre charge sur son propre fil d'exécution : les compteurs sont atomiques
+static atomic<size_t> octetsVivants(0);
+static atomic<size_t> allocationsVivantes(0);
+static atomic<unsigned long long> nbAllocations(0); // Toutes les allocations depuis le lancement
+
+/**
+* @brief Donne la taille utilisable d'un bloc rendu par malloc, que l'allocateur connaît déjà
+* @param[in] bloc: Le bloc
+* @return La taille du bloc, au moins celle demandée
+*/
+static size_t tailleBloc(void* bloc) {
+#ifdef _WIN32
+	return _msize(bloc);
+#else
+	return malloc_usable_size(bloc);
+#endif
+}
+/**
+* @brief Alloue un bloc et le compte
+* @param[in] taille: La taille demandée
+* @return Le bloc
+*/
+static void* allouerCompte(size_t taille) {
+	void* bloc = malloc(taille > 0 ? taille : 1);
+	if (bloc == nullptr) throw bad_alloc();
+	octetsVivants += tailleBloc(bloc);
+	++allocationsVivantes;
+	++nbAllocations;
+	return bloc;
+}
+/**
+* @brief Libère un bloc alloué par allouerCompte et le décompte
+* @param[in] bloc: Le bloc, ou nullptr
+*/
+static void libererCompte(void* bloc) {
+	if (bloc == nullptr) return;
+	octetsVivants -= tailleBloc(bloc);
+	--allocationsVivantes;
+	free(bloc);
+}
+void* operator new(size_t taille) {
+	return allouerCompte(taille);
+}
+void* operator new[](size_t taille) {
+	return allouerCompte(taille);
+}
+void operator delete(void* p) noexcept {
+	libererCompte(p);
+}
+void operator delete[](void* p) noexcept {
+	libererCompte(p);
+}
+void operator delete(void* p, size_t) noexcept {
+	libererCompte(p);
+}
+void operator delete[](void* p, size_t) noexcept {
+	libererCompte(p);
+}
+
+/**
+* @brief Dictionnaire chargé mot par mot, comme le faisait initialiserDico à l'origine
+*/
+struct DicoFlux {
+	char** mots;
+	unsigned int nbMot;
+};
+
+/**
+* @brief Ancien chargement : deux lectures du fichier et une allocation par mot
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier de mots
+*/
+void chargerDicoFlux(DicoFlux& d, const char* chemin) {
+	ifstream dico(chemin);
+
+	char* mot = new char[MAX];
+	d.nbMot = 0;
+	while (dico >> setw(MAX) >> mot) {
+		d.nbMot++;
+	}
+
+	dico.clear();
+	dico.seekg(0, ios::beg);
+
+	d.mots = new char* [d.nbMot];
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		dico >> setw(MAX) >> mot;
+		d.mots[i] = new char[strlen(mot) + 1];
+		strcpy(d.mots[i], mot);
+	}
+	delete[] mot;
+}
+/**
+* @brief Libère un dictionnaire chargé mot par mot
+* @param[in,out] d: Le dictionnaire à détruire
+*/
+void detruireDicoFlux(DicoFlux& d) {
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		delete[] d.mots[i];
+	}
+	delete[] d.mots;
+	d.mots = nullptr;
+	d.nbMot = 0;
+}
+/**
+* @brief Temps écoulé depuis un instant, en microsecondes
+* @param[in] debut: L'instant de départ
+* @return Le nombre de microsecondes écoulées
+*/
+double microsecondes(chrono::steady_clock::time_point debut) {
+	return chrono::duration<double, micro>(chrono::steady_clock::now() - debut).count();
+}
+
+/**
+* @brief Recherche dichotomique dans la zone des mots, comme le fait estMotValide sans la table
+* @param[in] d: Le dictionnaire
+* @param[in] mot: Le mot à chercher
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherZone(const Dico& d, const char* mot) {
+	unsigned int min = 0, max = d.nbMot;
+	while (min < max) {
+		unsigned int milieu = min + (max - min) / 2;
+		int c = comparerMot(motDico(d, milieu), mot);
+		if (c == 0) return true;
+		if (c < 0) min = milieu + 1;
+		else max = milieu;
+	}
+	return false;
+}
+/**
+* @brief Début d'une mesure du banc d'essai détaillé
+*/
+struct Mesure {
+	chrono::steady_clock::time_point debut;
+	unsigned long long allocations;
+};
+/**
+* @brief Commence une mesure
+* @param[out] m: La mesure
+*/
+void demarrer(Mesure& m) {
+	m.allocations = nbAllocations;
+	m.debut = chrono::steady_clock::now();
+}
+/**
+* @brief Termine une mesure et affiche sa ligne de résultat
+* @param[in] m: La mesure
+* @param[in] nom: Le nom de l'opération mesurée, sans espace
+* @param[in] operations: Le nombre d'opérations faites depuis le début de la mesure
+*/
+void arreter(const Mesure& m, const char* nom, unsigned long long operations) {
+	double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - m.debut).count();
+	unsigned long long allocations = nbAllocations - m.allocations;
+	cout << nom << '\t' << operations << '\t' << fixed << setprecision(1) << ns / operations
+		<< '\t' << setprecision(3) << (double)allocations / operations << endl;
+}
+/**
+* @brief Banc d'essai détaillé des opérations du jeu, avec une graine fixe pour être comparable d'une version à l'autre
+* @param[in] repetitions: Le nombre de chargements du dictionnaire, les autres opérations en font proportionnellement
+* @return 0, ou 2 si le dictionnaire n'a pas pu être ouvert
+*/
+int microBenchmarks(unsigned int repetitions) {
+	const unsigned int NB_ECHANTILLONS = 1 << 14;
+	const unsigned long long NB_RECHERCHES = 200000ull * repetitions;
+	const unsigned long long NB_COUPS = 100000ull * repetitions;
+	const unsigned long long NB_PARTIES = 1000ull * repetitions;
+	const char* joueurs[] = { "bench", "RR", nullptr };
+	Sortie sortieNulle;
+	initialiserSortieNulle(sortieNulle);
+
+	cout << "# nom\toperations\tns_par_op\tallocations_par_op" << endl;
+
+	// Le dictionnaire chargé depuis le disque, puis repris au registre comme le fait une partie suivante
+	Mesure m;
+	demarrer(m);
+	for (unsigned int r = 0; r < repetitions; ++r) {
+		Partie p;
+		p.sortie = &sortieNulle;
+		initialiserDico(p);
+		rendreDico(p.dicoPropre);
+		viderRegistre();
+	}
+	arreter(m, "initialiserDico", repetitions);
+	Partie garde;
+	garde.sortie = &sortieNulle;
+	initialiserDico(garde);
+	attendreDicoPartie(garde);
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_PARTIES; ++i) {
+		Partie p;
+		p.sortie = &sortieNulle;
+		initialiserDico(p);
+		rendreDico(p.dicoPropre);
+	}
+	arreter(m, "initialiserDico_registre", NB_PARTIES);
+	rendreDico(garde.dicoPropre);
+
+	Partie p;
+	initialiserPartie(p, joueurs, 1);
+	p.sortie = &sortieNulle;
+	attendreDicoPartie(p);
+	if (p.d->nbMot == 0) {
+		cout << "Dico pas ouvert : ./ods4.txt" << endl;
+		detruirePartie(p);
+		return 2;
+	}
+
+	// Mots tirés du dictionnaire, les mêmes à chaque lancement ; les absents ont leur dernière lettre changée
+	Generateur hasard;
+	initialiserGenerateur(hasard, 1);
+	char (*presents)[MAX] = new char[NB_ECHANTILLONS][MAX];
+	char (*absents)[MAX] = new char[NB_ECHANTILLONS][MAX];
+	char (*prefixes)[MAX] = new char[NB_ECHANTILLONS][MAX];
+	char (*verifies)[MAX] = new char[NB_ECHANTILLONS][MAX];
+	for (unsigned int i = 0; i < NB_ECHANTILLONS; ++i) {
+		const char* mot = motDico(*p.d, tirerBorne(hasard, p.d->nbMot));
+		unsigned int longueur = longueurMot(mot);
+		if (longueur > MAX - 1) longueur = MAX - 1;
+		memcpy(presents[i], mot, longueur);
+		presents[i][longueur] = '\0';
+		strcpy(absents[i], presents[i]);
+		do {
+			absents[i][longueur - 1] = (char)('A' + (absents[i][longueur - 1] - 'A' + 1) % 26);
+		} while (estMotValide(p, absents[i]));
+		// Préfixes de une à quatre lettres, comme ceux que voient les robots
+		unsigned int taille = 1 + tirerBorne(hasard, longueur < 4 ? longueur : 4);
+		memcpy(prefixes[i], mot, taille);
+		prefixes[i][taille] = '\0';
+		// Ce que verifNormal cherche après chaque lettre à partir de la troisième : presque jamais un mot
+		taille = (longueur < 3) ? longueur : 3 + tirerBorne(hasard, longueur - 2);
+		memcpy(verifies[i], mot, taille);
+		verifies[i][taille] = '\0';
+	}
+
+	unsigned int trouves = 0;
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		trouves += estMotValide(p, presents[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "estMotValide_present", NB_RECHERCHES);
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		trouves += estMotValide(p, absents[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "estMotValide_absent", NB_RECHERCHES);
+	if (trouves != NB_RECHERCHES) cout << "# erreur : " << trouves << " mots trouves sur " << NB_RECHERCHES << endl;
+
+	// La même recherche sur la zone des mots, puis sur les cases avec chaque jeu d'instructions disponible
+	trouves = 0;
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		trouves += chercherZone(*p.d, presents[i % NB_ECHANTILLONS]) + chercherZone(*p.d, absents[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "chercherZone", 2 * NB_RECHERCHES);
+	if (p.d->cases != nullptr || construireCases(*p.dicoPropre)) {
+		unsigned int meilleur = choisirSimd(SIMD_AVX2);
+		for (unsigned int niveau = SIMD_SCALAIRE; niveau <= meilleur; ++niveau) {
+			choisirSimd(niveau);
+			demarrer(m);
+			for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+				trouves += chercherCase(*p.d, presents[i % NB_ECHANTILLONS]) + chercherCase(*p.d, absents[i % NB_ECHANTILLONS]);
+			}
+			arreter(m, (string("chercherCase_") + nomSimd(niveau)).c_str(), 2 * NB_RECHERCHES);
+			unsigned int debut, fin, debutCases, finCases;
+			for (unsigned int i = 0; i < NB_ECHANTILLONS; ++i) {
+				intervallePrefixe(*p.d, prefixes[i], debut, fin);
+				intervalleCases(*p.d, prefixes[i], debutCases, finCases);
+				if (debut != debutCases || fin != finCases) {
+					cout << "# erreur : intervalle de " << prefixes[i] << " different avec " << nomSimd(niveau) << endl;
+					break;
+				}
+			}
+		}
+		choisirSimd(meilleur);
+		if (trouves != (meilleur + 2) * NB_RECHERCHES) cout << "# erreur : les cases ne trouvent pas les memes mots" << endl;
+	}
+	if (p.d->cles == nullptr) construireEytzinger(*p.dicoPropre);
+	trouves = 0;
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		trouves += chercherEytzinger(*p.d, presents[i % NB_ECHANTILLONS]) + chercherEytzinger(*p.d, absents[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "chercherEytzinger", 2 * NB_RECHERCHES);
+	if (trouves != NB_RECHERCHES) cout << "# erreur : l'index de Eytzinger ne trouve pas les memes mots" << endl;
+	if (p.d->filtre == nullptr) construireTable(*p.dicoPropre);
+	trouves = 0;
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		trouves += chercherTable(*p.d, presents[i % NB_ECHANTILLONS]) + chercherTable(*p.d, absents[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "chercherTable", 2 * NB_RECHERCHES);
+	if (trouves != NB_RECHERCHES) cout << "# erreur : la table ne trouve pas les memes mots" << endl;
+
+	// Les vérifications d'une manche, avant et après la table
+	unsigned int nbMots = 0, nbPasses = 0;
+	for (unsigned int i = 0; i < NB_ECHANTILLONS; ++i) {
+		bool estMot = chercherEytzinger(*p.d, verifies[i]);
+		if (estMot != chercherTable(*p.d, verifies[i])) cout << "# erreur : " << verifies[i] << " mal trouve par la table" << endl;
+		nbMots += estMot;
+		nbPasses += !estMot && filtrePasse(*p.d, verifies[i]);
+	}
+	cout << "# verifications : " << 100.0 * nbMots / NB_ECHANTILLONS << " % de mots, le filtre laisse passer "
+		<< 100.0 * nbPasses / (NB_ECHANTILLONS - nbMots) << " % des autres" << endl;
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		nbMots += chercherEytzinger(*p.d, verifies[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "verifNormal_Eytzinger", NB_RECHERCHES);
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		nbMots += chercherTable(*p.d, verifies[i % NB_ECHANTILLONS]);
+	}
+	arreter(m, "verifNormal_table", NB_RECHERCHES);
+
+	// Lettres candidates d'un préfixe tout entier, lues dans son noeud de l'arbre, que casNormalSaisiR suit maintenant lettre par lettre
+	unsigned int nbLettres = 0;
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_RECHERCHES; ++i) {
+		unsigned int noeud = noeudPrefixe(*p.d, prefixes[i % NB_ECHANTILLONS]);
+		if (noeud != AUCUN_NOEUD) nbLettres += p.d->noeuds[noeud].nbFils;
+	}
+	arreter(m, "noeudPrefixe", NB_RECHERCHES);
+
+	// Un coup du robot après un préfixe, pose du préfixe comprise
+	demarrer(m);
+	for (unsigned long long i = 0; i < NB_COUPS; ++i) {
+		const char* prefixe = prefixes[i % NB_ECHANTILLONS];
+		p.posLettre = 0;
+		p.motTap[0] = '\0';
+		p.noeudMotTap = 0;
+		for (unsigned int j = 0; prefixe[j] != '\0'; ++j) {
+			ajoutLettre(p, prefixe[j]);
+		}
+		saisiRobot(p);
+	}
+	arreter(m, "saisiRobot", NB_COUPS);
+
+	// Des parties entières entre deux robots, avec la table puis sans, estMotValide cherchant alors dans la zone des mots
+	Bilan b;
+	initialiserBilan(b, p.nbJoueurs);
+	initialiserGenerateur(p.hasard, 1);
+	demarrer(m);
+	simulerParties(p, NB_PARTIES, b);
+	arreter(m, "jouerPartie_RR", NB_PARTIES);
+	const unsigned long long* filtre = p.dicoPropre->filtre;
+	p.dicoPropre->filtre = nullptr;
+	initialiserGenerateur(p.hasard, 1);
+	demarrer(m);
+	simulerParties(p, NB_PARTIES, b);
+	arreter(m, "jouerPartie_RR_dichotomie", NB_PARTIES);
+	p.dicoPropre->filtre = filtre;
+	detruireBilan(b);
+
+	delete[] verifies;
+	delete[] prefixes;
+	delete[] absents;
+	delete[] presents;
+	detruirePartie(p);
+	StatistiquesRegistre registre = statistiquesRegistre();
+	cout << "# registre : " << registre.nbChargements << " chargements, " << registre.nbReutilisations << " reprises" << endl;
+	viderRegistre();
+	if (nbLettres == 0) cout << "# erreur : aucune lettre candidate" << endl;
+	return 0;
+}
+
+/**
+* @brief Essai de charge du robot : le temps de chacun de ses coups après tous les préfixes de zéro, une et deux lettres,
+* puis après ces préfixes suivis d'un '?', où il doit donner un mot
+* @param[in] seuil: La durée d'un coup en ns au-delà de laquelle il est compté, 0 sans seuil
+* @param[in] repetitions: Le nombre de coups joués après chaque préfixe
+* @return 0, 1 si un coup a dépassé le seuil, ou 2 si le dictionnaire n'a pas pu être ouvert
+*/
+int pireCoup(unsigned long long seuil, unsigned int repetitions) {
+	const char* joueurs[] = { "bench", "RR", nullptr };
+	Sortie sortieNulle;
+	initialiserSortieNulle(sortieNulle);
+	Partie p;
+	initialiserPartie(p, joueurs, 1);
+	p.sortie = &sortieNulle;
+	attendreDicoPartie(p);
+	if (p.d->nbMot == 0) {
+		cout << "Dico pas ouvert : ./ods4.txt" << endl;
+		detruirePartie(p);
+		return 2;
+	}
+
+	cout << "# longueur\tcontestation\tprefixes\tns_moyen\tns_pire\tprefixe_pire" << endl;
+	unsigned long long pire = 0, nbHorsSeuil = 0;
+	char prefixePire[4] = "";
+	for (unsigned int longueur = 0; longueur <= 2; ++longueur) {
+		for (unsigned int conteste = 0; conteste <= 1; ++conteste) {
+			if (longueur == 0 && conteste == 1) continue; // Pas de '?' avant la première lettre
+			unsigned int nbPrefixes = (longueur == 0) ? 1 : (longueur == 1) ? 26 : 26 * 26;
+			unsigned long long total = 0, pireGroupe = 0;
+			char prefixePireGroupe[4] = "";
+			for (unsigned int n = 0; n < nbPrefixes; ++n) {
+				char prefixe[4];
+				for (unsigned int j = 0, reste = n; j < longueur; ++j, reste /= 26) {
+					prefixe[longueur - 1 - j] = (char)('A' + reste % 26);
+				}
+				prefixe[longueur] = conteste ? '?' : '\0';
+				prefixe[longueur + 1] = '\0';
+
+				for (unsigned int r = 0; r < repetitions; ++r) {
+					p.posLettre = 0;
+					p.motTap[0] = '\0';
+					p.noeudMotTap = 0;
+					for (unsigned int j = 0; prefixe[j] != '\0'; ++j) {
+						ajoutLettre(p, prefixe[j]);
+					}
+					chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+					saisiRobot(p);
+					unsigned long long ns = (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - debut).count();
+					total += ns;
+					if (seuil > 0 && ns > seuil) ++nbHorsSeuil;
+					if (ns > pireGroupe) {
+						pireGroupe = ns;
+						strcpy(prefixePireGroupe, prefixe);
+					}
+				}
+			}
+			cout << longueur << '\t' << conteste << '\t' << nbPrefixes << '\t' << fixed << setprecision(1)
+				<< (double)total / ((unsigned long long)nbPrefixes * repetitions) << '\t' << pireGroupe << '\t'
+				<< (prefixePireGroupe[0] == '\0' ? "-" : prefixePireGroupe) << endl;
+			if (pireGroupe > pire) {
+				pire = pireGroupe;
+				strcpy(prefixePire, prefixePireGroupe);
+			}
+		}
+	}
+	cout << "# pire coup : " << pire << " ns apres " << (prefixePire[0] == '\0' ? "-" : prefixePire);
+	if (seuil > 0) cout << ", " << nbHorsSeuil << " coups au-dela du seuil de " << seuil << " ns";
+	cout << endl;
+
+	detruirePartie(p);
+	viderRegistre();
+	return nbHorsSeuil > 0 ? 1 : 0;
+}
+
+int main(int argc, const char* argv[]) {
+	if (argc > 1 && strcmp(argv[1], "--micro") == 0) {
+		unsigned int repetitions = (argc > 2) ? (unsigned int)atoi(argv[2]) : 5;
+		return microBenchmarks(repetitions == 0 ? 1 : repetitions);
+	}
+	if (argc > 1 && strcmp(argv[1], "--pire") == 0) {
+		unsigned long long seuil = (argc > 2) ? (unsigned long long)atoll(argv[2]) * 1000 : 0;
+		unsigned int repetitions = (argc > 3) ? (unsigned int)atoi(argv[3]) : 100;
+		return pireCoup(seuil, repetitions == 0 ? 1 : repetitions);
+	}
+
+	const char* chemin = (argc > 1) ? argv[1] : "./ods4.txt";
+	unsigned int repetitions = (argc > 2) ? (unsigned int)atoi(argv[2]) : 5;
+	if (repetitions == 0) repetitions = 1;
+
+	double fluxCharge = 0, fluxLibere = 0, zoneCharge = 0, zoneLibere = 0, projCharge = 0, projLibere = 0;
+	double binCharge = 0, binLibere = 0, arbre = 0;
+	unsigned int nbFlux = 0, nbZone = 0, nbProj = 0, nbBin = 0, nbNoeuds = 0;
+
+	// Le dictionnaire binaire est compilé à côté du fichier de mots
+	string cheminBin = string(chemin) + ".bin";
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+	if (!compilerDico(chemin, cheminBin.c_str())) {
+		cout << "Impossible de compiler " << cheminBin << endl;
+		return 2;
+	}
+	double compilation = microsecondes(debut);
+
+	for (unsigned int r = 0; r < repetitions; ++r) {
+		DicoFlux df;
+		chrono::steady_clock::time_point t = chrono::steady_clock::now();
+		chargerDicoFlux(df, chemin);
+		fluxCharge += microsecondes(t);
+		nbFlux = df.nbMot;
+		t = chrono::steady_clock::now();
+		detruireDicoFlux(df);
+		fluxLibere += microsecondes(t);
+
+		Dico d;
+		t = chrono::steady_clock::now();
+		if (!chargerDico(d, chemin)) {
+			cout << "Dico pas ouvert : " << chemin << endl;
+			return 2;
+		}
+		zoneCharge += microsecondes(t);
+		nbZone = d.nbMot;
+		t = chrono::steady_clock::now();
+		detruireDico(d);
+		zoneLibere += microsecondes(t);
+
+		t = chrono::steady_clock::now();
+		if (projeterDico(d, chemin)) {
+			projCharge += microsecondes(t);
+			nbProj = d.nbMot;
+			t = chrono::steady_clock::now();
+			detruireDico(d);
+			projLibere += microsecondes(t);
+		}
+
+		t = chrono::steady_clock::now();
+		if (!chargerDicoBinaire(d, cheminBin.c_str(), chemin)) {
+			cout << "Dico binaire pas chargé : " << cheminBin << endl;
+			return 2;
+		}
+		binCharge += microsecondes(t);
+		nbBin = d.nbMot;
+		t = chrono::steady_clock::now();
+		construireArbre(d);
+		arbre += microsecondes(t);
+		nbNoeuds = d.nbNoeuds;
+		t = chrono::steady_clock::now();
+		detruireDico(d);
+		binLibere += microsecondes(t);
+	}
+
+	if (nbFlux != nbZone || (nbProj != 0 && nbProj != nbZone) || nbBin != nbZone) {
+		cout << "Nombre de mots différent : " << nbFlux << " / " << nbZone << " / " << nbProj << " / " << nbBin << endl;
+		return 1;
+	}
+
+	cout << fixed << setprecision(1);
+	cout << "mots " << nbZone << ", repetitions " << repetitions << endl;
+	cout << "flux  chargement " << fluxCharge / repetitions << " us, liberation " << fluxLibere / repetitions << " us" << endl;
+	cout << "zone  chargement " << zoneCharge / repetitions << " us, liberation " << zoneLibere / repetitions << " us" << endl;
+	if (nbProj != 0) {
+		cout << "mmap  chargement " << projCharge / repetitions << " us, liberation " << projLibere / repetitions << " us" << endl;
+	}
+	else cout << "mmap  indisponible pour ce fichier" << endl;
+	cout << "bin   chargement " << binCharge / repetitions << " us, liberation " << binLibere / repetitions << " us"
+		<< " (compilation " << compilation << " us)" << endl;
+	cout << "arbre construction " << arbre / repetitions << " us, " << nbNoeuds << " noeuds" << endl;
+
+	// Mémoire gardée par chaque représentation une fois chargée (tailles utilisables des blocs, hors entêtes de l'allocateur)
+	DicoFlux df;
+	size_t avant = octetsVivants, blocs = allocationsVivantes;
+	chargerDicoFlux(df, chemin);
+	size_t octetsFlux = octetsVivants - avant;
+	cout << "memoire char**  " << octetsFlux << " o en " << allocationsVivantes - blocs << " blocs" << endl;
+	detruireDicoFlux(df);
+
+	// Le binaire apporte l'arbre, le filtre et la table dans sa projection, partagée entre les processus
+	Dico bin;
+	avant = octetsVivants;
+	chargerDicoBinaire(bin, cheminBin.c_str(), chemin);
+	size_t octetsBinaire = octetsVivants - avant, octetsProjection = bin.tailleProjection;
+	cout << "memoire binaire " << octetsBinaire << " o, projection partagee " << octetsProjection << " o" << endl;
+	detruireDico(bin);
+
+	Dico d;
+	avant = octetsVivants;
+	blocs = allocationsVivantes;
+	chargerDico(d, chemin);
+	cout << "memoire zone    " << octetsVivants - avant << " o en " << allocationsVivantes - blocs << " blocs" << endl;
+	avant = octetsVivants;
+	construireArbre(d);
+	cout << "memoire arbre   " << octetsVivants - avant << " o" << endl;
+
+	Dawg g;
+	chrono::steady_clock::time_point t = chrono::steady_clock::now();
+	if (!construireDawg(g, d)) {
+		cout << "automate trop grand" << endl;
+		detruireDico(d);
+		return 1;
+	}
+	double construction = microsecondes(t);
+	cout << "memoire dawg    " << tailleDawg(g) << " o, " << g.nbArcs << " arcs, construction " << construction << " us" << endl;
+
+	// Empreinte de parties lancées chacune dans son processus : le jeu projette le binaire, compté une seule fois,
+	// l'automate n'est pas utilisé par le jeu et n'est donné que pour comparaison
+	const size_t NB_PROCESSUS[] = { 1, 8 };
+	for (unsigned int i = 0; i < sizeof(NB_PROCESSUS) / sizeof(NB_PROCESSUS[0]); ++i) {
+		size_t n = NB_PROCESSUS[i];
+		cout << "empreinte " << n << " processus : char** " << n * octetsFlux
+			<< " o, jeu (binaire) " << n * octetsBinaire + octetsProjection << " o, dawg " << n * tailleDawg(g) << " o" << endl;
+	}
+
+	// L'automate reconnaît exactement les mots du dictionnaire
+	unsigned int nbDistincts = 0;
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		if (!dawgContient(g, motDico(d, i))) {
+			cout << "mot absent de l'automate : " << motDico(d, i) << endl;
+			return 1;
+		}
+		if (i == 0 || comparerMot(motDico(d, i), motDico(d, i - 1)) != 0) ++nbDistincts;
+	}
+	if (enumererDawg(g, "", nullptr, nullptr) != nbDistincts) {
+		cout << "l'automate ne donne pas " << nbDistincts << " mots" << endl;
+		return 1;
+	}
+	detruireDawg(g);
+	detruireDico(d);
+	return 0;
+}
@@ -0,0 +1,277 @@
+/**
+ * @file cases.cpp
+ * @brief Composant des mots rangés dans des cases de taille fixe, comparés par instructions vectorielles
+ *
+ * Les cases sont complétées par des '\0' : comparer deux cases octet par octet, sans signe, donne l'ordre de strcmp.
+ * Le jeu d'instructions est choisi une fois, d'après le processeur, et chaque recherche l'utilise à chaque étape.
+ * Seul bench construit les cases, pour les comparer aux autres recherches : le jeu cherche les mots dans la table.
+ */
+
+#include <cstring>
+#include <new>
+
+#include "cases.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AVEC_SIMD
+#define CIBLE_SSE2 __attribute__((target("sse2")))
+#define CIBLE_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define AVEC_SIMD
+#define CIBLE_SSE2
+#define CIBLE_AVX2
+#endif
+
+using namespace std;
+
+/**
+* @brief Donne la position du premier bit à 1
+* @param[in] x: L'entier, non nul
+* @return La position, 0 pour le bit de poids faible
+*/
+static inline unsigned int premierBit(unsigned int x) {
+#ifdef _MSC_VER
+	unsigned long i;
+	_BitScanForward(&i, x);
+	return (unsigned int)i;
+#else
+	return (unsigned int)__builtin_ctz(x);
+#endif
+}
+/**
+* @brief Donne les octets comparés : les longueur premiers
+* @param[in] longueur: Le nombre d'octets comparés, au plus TAILLE_CASE
+* @return Un bit par octet comparé
+*/
+static inline unsigned int masqueLongueur(unsigned int longueur) {
+	return (longueur >= TAILLE_CASE) ? 0xFFFFFFFFu : (1u << longueur) - 1;
+}
+/**
+* @brief Compare le début de deux cases, huit octets à la fois
+* @param[in] a: La première case
+* @param[in] b: La seconde case
+* @param[in] longueur: Le nombre d'octets comparés
+* @return Négatif, nul ou positif selon que a est avant, égal ou après b sur ces octets
+*/
+static inline int comparerScalaire(const char* a, const char* b, unsigned int longueur) {
+	for (unsigned int i = 0; i < longueur; i += 8) {
+		unsigned long long x, y;
+		memcpy(&x, a + i, 8);
+		memcpy(&y, b + i, 8);
+		if (x != y) {
+			unsigned int j = i;
+			while (a[j] == b[j]) ++j;
+			if (j >= longueur) return 0;
+			return (int)(unsigned char)a[j] - (int)(unsigned char)b[j];
+		}
+	}
+	return 0;
+}
+#ifdef AVEC_SIMD
+/**
+* @brief Compare le début de deux cases par deux comparaisons de 16 octets
+* @param[in] a: La première case, alignée
+* @param[in] b: La seconde case, alignée
+* @param[in] masque: Un bit par octet comparé
+* @return Négatif, nul ou positif selon que a est avant, égal ou après b sur ces octets
+*/
+CIBLE_SSE2 static inline int comparerSse2(const char* a, const char* b, unsigned int masque) {
+	__m128i basA = _mm_load_si128((const __m128i*)a), hautA = _mm_load_si128((const __m128i*)(a + 16));
+	__m128i basB = _mm_load_si128((const __m128i*)b), hautB = _mm_load_si128((const __m128i*)(b + 16));
+	unsigned int egaux = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(basA, basB))
+		| ((unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(hautA, hautB)) << 16);
+	unsigned int differents = ~egaux & masque;
+	if (differents == 0) return 0;
+	unsigned int j = premierBit(differents);
+	return (int)(unsigned char)a[j] - (int)(unsigned char)b[j];
+}
+/**
+* @brief Compare le début de deux cases par une comparaison de 32 octets
+* @param[in] a: La première case, alignée
+* @param[in] b: La seconde case, alignée
+* @param[in] masque: Un bit par octet comparé
+* @return Négatif, nul ou positif selon que a est avant, égal ou après b sur ces octets
+*/
+CIBLE_AVX2 static inline int comparerAvx2(const char* a, const char* b, unsigned int masque) {
+	__m256i x = _mm256_load_si256((const __m256i*)a);
+	__m256i y = _mm256_load_si256((const __m256i*)b);
+	unsigned int differents = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) & masque;
+	if (differents == 0) return 0;
+	unsigned int j = premierBit(differents);
+	return (int)(unsigned char)a[j] - (int)(unsigned char)b[j];
+}
+#endif
+
+/**
+* @brief Cherche la première case qui n'est pas avant la clé (ou qui est après, si strict), sur les longueur premiers octets
+* @param[in] cases: Les cases, triées
+* @param[in] nbMot: Le nombre de cases
+* @param[in] cle: La clé, dans une case alignée
+* @param[in] longueur: Le nombre d'octets comparés
+* @param[in] strict: Vrai pour sauter aussi les cases égales à la clé
+* @return L'indice de la case, nbMot s'il n'y en a aucune
+*/
+static unsigned int borneScalaire(const char* cases, unsigned int nbMot, const char* cle, unsigned int longueur, bool strict) {
+	unsigned int min = 0, max = nbMot;
+	while (min < max) {
+		unsigned int milieu = min + (max - min) / 2;
+		int c = comparerScalaire(cases + (size_t)milieu * TAILLE_CASE, cle, longueur);
+		if (c < 0 || (strict && c == 0)) min = milieu + 1;
+		else max = milieu;
+	}
+	return min;
+}
+#ifdef AVEC_SIMD
+/**
+* @brief Comme borneScalaire, avec SSE2
+*/
+CIBLE_SSE2 static unsigned int borneSse2(const char* cases, unsigned int nbMot, const char* cle, unsigned int longueur, bool strict) {
+	unsigned int masque = masqueLongueur(longueur);
+	unsigned int min = 0, max = nbMot;
+	while (min < max) {
+		unsigned int milieu = min + (max - min) / 2;
+		int c = comparerSse2(cases + (size_t)milieu * TAILLE_CASE, cle, masque);
+		if (c < 0 || (strict && c == 0)) min = milieu + 1;
+		else max = milieu;
+	}
+	return min;
+}
+/**
+* @brief Comme borneScalaire, avec AVX2
+*/
+CIBLE_AVX2 static unsigned int borneAvx2(const char* cases, unsigned int nbMot, const char* cle, unsigned int longueur, bool strict) {
+	unsigned int masque = masqueLongueur(longueur);
+	unsigned int min = 0, max = nbMot;
+	while (min < max) {
+		unsigned int milieu = min + (max - min) / 2;
+		int c = comparerAvx2(cases + (size_t)milieu * TAILLE_CASE, cle, masque);
+		if (c < 0 || (strict && c == 0)) min = milieu + 1;
+		else max = milieu;
+	}
+	return min;
+}
+#endif
+
+// Recherche retenue par choisirSimd
+static unsigned int (*borne)(const char*, unsigned int, const char*, unsigned int, bool) = borneScalaire;
+
+/**
+* @brief Donne le meilleur jeu d'instructions que le processeur et le système permettent
+* @return SIMD_SCALAIRE, SIMD_SSE2 ou SIMD_AVX2
+*/
+static unsigned int detecterSimd() {
+#if defined(AVEC_SIMD) && defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+	if (__builtin_cpu_supports("sse2")) return SIMD_SSE2;
+#elif defined(AVEC_SIMD)
+	int infos[4];
+	__cpuid(infos, 1);
+	bool sse2 = (infos[3] & (1 << 26)) != 0;
+	// AVX2 demande aussi que le système sauvegarde les registres de 256 bits (OSXSAVE, puis XCR0)
+	bool avx = (infos[2] & (1 << 27)) != 0 && (infos[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+	__cpuidex(infos, 7, 0);
+	if (avx && (infos[1] & (1 << 5)) != 0) return SIMD_AVX2;
+	if (sse2) return SIMD_SSE2;
+#endif
+	return SIMD_SCALAIRE;
+}
+/**
+* @brief Choisit le jeu d'instructions des comparaisons, le meilleur disponible est choisi au lancement
+* @param[in] niveau: Le jeu d'instructions souhaité (SIMD_SCALAIRE, SIMD_SSE2 ou SIMD_AVX2)
+* @return Le jeu d'instructions retenu, le plus proche de niveau que le processeur permet
+*/
+unsigned int choisirSimd(unsigned int niveau) {
+	unsigned int disponible = detecterSimd();
+	if (niveau > disponible) niveau = disponible;
+	borne = borneScalaire;
+#ifdef AVEC_SIMD
+	if (niveau == SIMD_SSE2) borne = borneSse2;
+	else if (niveau == SIMD_AVX2) borne = borneAvx2;
+#endif
+	return niveau;
+}
+// Au lancement, le meilleur jeu d'instructions disponible est retenu
+static const unsigned int simdDepart = choisirSimd(SIMD_AVX2);
+/**
+* @brief Donne le nom d'un jeu d'instructions
+* @param[in] niveau: Le jeu d'instructions
+* @return Le nom, sans espace
+*/
+const char* nomSimd(unsigned int niveau) {
+	switch (niveau) {
+	case SIMD_SSE2: return "sse2";
+	case SIMD_AVX2: return "avx2";
+	default: return "scalaire";
+	}
+}
+/**
+* @brief Range les mots du dictionnaire dans des cases de TAILLE_CASE octets alignées, complétées par des '\0'
+* @param[in,out] d: Le dictionnaire chargé, trié
+* @return Faux si un mot est trop long pour sa case, le dictionnaire reste alors sans cases
+* @see detruireDico
+*/
+bool construireCases(Dico& d) {
+	char* cases = static_cast<char*>(::operator new[]((size_t)d.nbMot * TAILLE_CASE, align_val_t(TAILLE_CASE)));
+	memset(cases, 0, (size_t)d.nbMot * TAILLE_CASE);
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		const char* mot = motDico(d, i);
+		unsigned int longueur = longueurMot(mot);
+		if (longueur >= TAILLE_CASE) {
+			::operator delete[](cases, align_val_t(TAILLE_CASE));
+			return false;
+		}
+		memcpy(cases + (size_t)i * TAILLE_CASE, mot, longueur);
+	}
+	d.cases = cases;
+	return true;
+}
+/**
+* @brief Range un mot ou un préfixe dans une case
+* @param[out] cle: La case, alignée
+* @param[in] mot: Le mot, terminé par '\0'
+* @return La longueur du mot, TAILLE_CASE s'il ne tient pas dans la case
+*/
+static unsigned int remplirCle(char* cle, const char* mot) {
+	memset(cle, 0, TAILLE_CASE);
+	unsigned int longueur = 0;
+	while (mot[longueur] != '\0') {
+		if (longueur == TAILLE_CASE - 1) return TAILLE_CASE;
+		cle[longueur] = mot[longueur];
+		++longueur;
+	}
+	return longueur;
+}
+/**
+* @brief Vérifie si un mot est dans le dictionnaire, par recherche dichotomique sur les cases
+* @param[in] d: Le dictionnaire, dont les cases sont construites
+* @param[in] mot: Le mot à chercher, terminé par '\0'
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherCase(const Dico& d, const char* mot) {
+	alignas(TAILLE_CASE) char cle[TAILLE_CASE];
+	if (remplirCle(cle, mot) == TAILLE_CASE) return false; // Plus long que tous les mots
+	unsigned int i = borne(d.cases, d.nbMot, cle, TAILLE_CASE, false);
+	return i < d.nbMot && memcmp(d.cases + (size_t)i * TAILLE_CASE, cle, TAILLE_CASE) == 0;
+}
+/**
+* @brief Cherche les mots qui commencent par un préfixe, par deux recherches dichotomiques sur les cases
+* @param[in] d: Le dictionnaire, dont les cases sont construites
+* @param[in] prefixe: Le préfixe cherché, terminé par '\0'
+* @param[out] debut: L'indice du premier mot qui commence par le préfixe
+* @param[out] fin: L'indice qui suit le dernier mot qui commence par le préfixe
+* @see intervallePrefixe
+*/
+void intervalleCases(const Dico& d, const char* prefixe, unsigned int& debut, unsigned int& fin) {
+	alignas(TAILLE_CASE) char cle[TAILLE_CASE];
+	unsigned int longueur = remplirCle(cle, prefixe);
+	if (longueur == TAILLE_CASE) {
+		debut = fin = 0;
+		return;
+	}
+	debut = borne(d.cases, d.nbMot, cle, longueur, false);
+	fin = debut + borne(d.cases + (size_t)debut * TAILLE_CASE, d.nbMot - debut, cle, longueur, true);
+}
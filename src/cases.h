@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef _CASES_
+#define _CASES_
+
+/**
+ * @file cases.h
+ * @brief Entête du composant des mots rangés dans des cases de taille fixe, comparés par instructions vectorielles
+ */
+
+#include "dico.h"
+
+ /**
+ * @brief Jeux d'instructions utilisables pour comparer les cases
+ */
+enum {
+	SIMD_SCALAIRE, // Huit octets à la fois, sur tous les processeurs
+	SIMD_SSE2, // Deux comparaisons de 16 octets
+	SIMD_AVX2, // Une comparaison de 32 octets
+};
+
+/**
+* @brief Range les mots du dictionnaire dans des cases de TAILLE_CASE octets alignées, complétées par des '\0'
+* @param[in,out] d: Le dictionnaire chargé, trié
+* @return Faux si un mot est trop long pour sa case, le dictionnaire reste alors sans cases
+* @see detruireDico
+*/
+bool construireCases(Dico& d);
+/**
+* @brief Choisit le jeu d'instructions des comparaisons, le meilleur disponible est choisi au lancement
+* @param[in] niveau: Le jeu d'instructions souhaité (SIMD_SCALAIRE, SIMD_SSE2 ou SIMD_AVX2)
+* @return Le jeu d'instructions retenu, le plus proche de niveau que le processeur permet
+*/
+unsigned int choisirSimd(unsigned int niveau);
+/**
+* @brief Donne le nom d'un jeu d'instructions
+* @param[in] niveau: Le jeu d'instructions
+* @return Le nom, sans espace
+*/
+const char* nomSimd(unsigned int niveau);
+/**
+* @brief Vérifie si un mot est dans le dictionnaire, par recherche dichotomique sur les cases
+* @param[in] d: Le dictionnaire, dont les cases sont construites
+* @param[in] mot: Le mot à chercher, terminé par '\0'
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherCase(const Dico& d, const char* mot);
+/**
+* @brief Cherche les mots qui commencent par un préfixe, par deux recherches dichotomiques sur les cases
+* @param[in] d: Le dictionnaire, dont les cases sont construites
+* @param[in] prefixe: Le préfixe cherché, terminé par '\0'
+* @param[out] debut: L'indice du premier mot qui commence par le préfixe
+* @param[out] fin: L'indice qui suit le dernier mot qui commence par le préfixe
+* @see intervallePrefixe
+*/
+void intervalleCases(const Dico& d, const char* prefixe, unsigned int& debut, unsigned int& fin);
+
+
+#endif // !_CASES_
@@ -0,0 +1,36 @@
+/**
+ * @file compilDico.cpp
+ * @brief Compile le fichier de mots, son arbre des préfixes et sa table de hachage en dictionnaire binaire projeté directement par le jeu
+ *
+ * Compilation : g++ -O2 -std=c++17 -pthread dico.cpp table.cpp statistiques.cpp compilDico.cpp -o compilDico
+ * Utilisation : compilDico [fichier de mots] [fichier binaire]
+ */
+
+#include <iostream>
+
+#include "dico.h"
+
+using namespace std;
+
+int main(int argc, const char* argv[]) {
+	const char* source = (argc > 1) ? argv[1] : "./ods4.txt";
+	char* binaire = cheminBinaire(source);
+	const char* destination = (argc > 2) ? argv[2] : binaire;
+
+	int code = 0;
+	Dico d;
+	if (!compilerDico(source, destination)) {
+		cout << "Impossible de compiler " << source << " vers " << destination << endl;
+		code = 2;
+	}
+	else if (!chargerDicoBinaire(d, destination, source)) {
+		cout << "Le fichier " << destination << " ne se relit pas" << endl;
+		code = 1;
+	}
+	else {
+		cout << destination << " : " << d.nbMot << " mots, " << d.nbNoeuds << " noeuds, version " << VERSION_DICO << endl;
+		detruireDico(d);
+	}
+	delete[] binaire;
+	return code;
+}
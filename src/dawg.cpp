@@ -0,0 +1,208 @@
+/**
+ * @file dawg.cpp
+ * @brief Composant automate minimal (DAWG) des mots du dictionnaire
+ */
+
+#include <cstring>
+
+#include "dawg.h"
+
+using namespace std;
+
+/**
+* @brief Calcule l'empreinte d'une liste d'arcs
+* @param[in] arcs: Les arcs, le dernier est marqué ARC_DERNIER
+* @return L'empreinte
+*/
+static unsigned int empreinteArcs(const unsigned int* arcs) {
+	unsigned int empreinte = 2166136261u;
+	unsigned int i = 0;
+	do {
+		empreinte = (empreinte ^ arcs[i]) * 16777619u;
+	} while (!(arcs[i++] & ARC_DERNIER));
+	return empreinte ^ (empreinte >> 15);
+}
+/**
+* @brief Compare deux listes d'arcs
+* @param[in] a: La première liste, le dernier arc est marqué ARC_DERNIER
+* @param[in] b: La seconde liste
+* @return Vrai si les deux listes sont identiques
+*/
+static bool memesArcs(const unsigned int* a, const unsigned int* b) {
+	unsigned int i = 0;
+	do {
+		if (a[i] != b[i]) return false;
+	} while (!(a[i++] & ARC_DERNIER));
+	return true;
+}
+/**
+* @brief Construit l'automate minimal à partir de l'arbre des préfixes d'un dictionnaire
+* @param[out] g: L'automate à construire
+* @param[in] d: Le dictionnaire, dont l'arbre est construit
+* @return Faux si l'automate a trop d'arcs pour être représenté
+* @see construireArbre, detruireDawg
+*/
+bool construireDawg(Dawg& g, const Dico& d) {
+	g.arcs = nullptr;
+	g.nbArcs = 0;
+	g.racine = 0;
+	if (d.nbNoeuds == 0) return true;
+
+	// Un noeud de l'arbre a toujours un indice plus petit que ses descendants : en parcourant
+	// l'arbre à l'envers, les états des fils sont connus avant ceux de leur père
+	unsigned int* etat = new unsigned int[d.nbNoeuds];
+	unsigned int* arcs = new unsigned int[d.nbNoeuds + 1];
+	unsigned int nbArcs = 1; // L'arc 0 n'est pas utilisé, 0 est l'état sans arc
+
+	// Table des états déjà rangés, par empreinte de leurs arcs
+	unsigned int tailleTable = 1;
+	while (tailleTable < 2 * d.nbNoeuds) tailleTable *= 2;
+	unsigned int* table = new unsigned int[tailleTable];
+	memset(table, 0, tailleTable * sizeof(unsigned int));
+
+	unsigned int liste[256];
+	bool trop = false;
+	for (unsigned int i = d.nbNoeuds; i-- > 0 && !trop;) {
+		const Noeud& n = d.noeuds[i];
+		if (n.nbFils == 0) {
+			etat[i] = 0;
+			continue;
+		}
+		for (unsigned int f = 0; f < n.nbFils; ++f) {
+			const Noeud& fils = d.noeuds[n.premierFils + f];
+			liste[f] = (unsigned char)fils.lettre | (fils.estMot ? ARC_MOT : 0) | (etat[n.premierFils + f] << ARC_DECALAGE);
+		}
+		liste[n.nbFils - 1] |= ARC_DERNIER;
+
+		unsigned int place = empreinteArcs(liste) & (tailleTable - 1);
+		while (table[place] != 0 && !memesArcs(arcs + table[place], liste)) {
+			place = (place + 1) & (tailleTable - 1);
+		}
+		if (table[place] == 0) {
+			if (nbArcs + n.nbFils > ARC_MAX_CIBLE) {
+				trop = true;
+				break;
+			}
+			table[place] = nbArcs;
+			memcpy(arcs + nbArcs, liste, n.nbFils * sizeof(unsigned int));
+			nbArcs += n.nbFils;
+		}
+		etat[i] = table[place];
+	}
+
+	if (!trop) {
+		g.racine = etat[0];
+		g.nbArcs = nbArcs;
+		g.arcs = new unsigned int[nbArcs];
+		memcpy(g.arcs, arcs, nbArcs * sizeof(unsigned int));
+		g.arcs[0] = ARC_DERNIER;
+	}
+	delete[] table;
+	delete[] arcs;
+	delete[] etat;
+	return !trop;
+}
+/**
+* @brief Cherche l'arc d'un état qui porte une lettre
+* @param[in] g: L'automate
+* @param[in] etat: L'état
+* @param[in] lettre: La lettre
+* @return L'indice de l'arc, 0 s'il n'y en a pas
+*/
+static unsigned int arcLettre(const Dawg& g, unsigned int etat, char lettre) {
+	if (etat == 0) return 0;
+	unsigned int i = etat;
+	do {
+		if ((g.arcs[i] & ARC_LETTRE) == (unsigned char)lettre) return i;
+	} while (!(g.arcs[i++] & ARC_DERNIER));
+	return 0;
+}
+/**
+* @brief Vérifie si un mot est reconnu par l'automate
+* @param[in] g: L'automate
+* @param[in] mot: Le mot à vérifier
+* @return Vrai si le mot est un mot du dictionnaire, faux sinon
+*/
+bool dawgContient(const Dawg& g, const char* mot) {
+	unsigned int etat = g.racine;
+	unsigned int arc = 0;
+	for (unsigned int i = 0; !estFinMot(mot[i]); ++i) {
+		arc = arcLettre(g, etat, mot[i]);
+		if (arc == 0) return false;
+		etat = g.arcs[arc] >> ARC_DECALAGE;
+	}
+	return arc != 0 && (g.arcs[arc] & ARC_MOT);
+}
+/**
+* @brief Parcourt récursivement les mots accessibles depuis un état
+* @param[in] g: L'automate
+* @param[in] etat: L'état de départ
+* @param[in,out] mot: Le préfixe lu jusqu'à l'état, complété au fil du parcours
+* @param[in] longueur: La longueur du préfixe
+* @param[in] traiter: Fonction appelée pour chaque mot, nullptr pour seulement compter
+* @param[in,out] contexte: Donnée transmise à traiter
+* @return Le nombre de mots trouvés
+*/
+static unsigned int parcourirDawg(const Dawg& g, unsigned int etat, char* mot, unsigned int longueur,
+	void (*traiter)(const char* mot, void* contexte), void* contexte) {
+	if (etat == 0 || longueur + 1 >= MAX) return 0;
+	unsigned int nb = 0;
+	unsigned int i = etat;
+	do {
+		mot[longueur] = (char)(g.arcs[i] & ARC_LETTRE);
+		mot[longueur + 1] = '\0';
+		if (g.arcs[i] & ARC_MOT) {
+			++nb;
+			if (traiter != nullptr) traiter(mot, contexte);
+		}
+		nb += parcourirDawg(g, g.arcs[i] >> ARC_DECALAGE, mot, longueur + 1, traiter, contexte);
+	} while (!(g.arcs[i++] & ARC_DERNIER));
+	return nb;
+}
+/**
+* @brief Parcourt par ordre alphabétique les mots qui commencent par un préfixe
+* @param[in] g: L'automate
+* @param[in] prefixe: Le préfixe, terminé par '\0'
+* @param[in] traiter: Fonction appelée pour chaque mot, nullptr pour seulement compter
+* @param[in,out] contexte: Donnée transmise à traiter
+* @return Le nombre de mots qui commencent par le préfixe
+*/
+unsigned int enumererDawg(const Dawg& g, const char* prefixe, void (*traiter)(const char* mot, void* contexte), void* contexte) {
+	char mot[MAX];
+	unsigned int longueur = (unsigned int)strlen(prefixe);
+	if (longueur >= MAX) return 0;
+	strcpy(mot, prefixe);
+
+	// État atteint en lisant le préfixe, qui est lui-même un mot si le dernier arc lu l'indique
+	unsigned int etat = g.racine;
+	unsigned int arc = 0;
+	for (unsigned int i = 0; i < longueur; ++i) {
+		arc = arcLettre(g, etat, prefixe[i]);
+		if (arc == 0) return 0;
+		etat = g.arcs[arc] >> ARC_DECALAGE;
+	}
+	unsigned int nb = 0;
+	if (arc != 0 && (g.arcs[arc] & ARC_MOT)) {
+		++nb;
+		if (traiter != nullptr) traiter(mot, contexte);
+	}
+	return nb + parcourirDawg(g, etat, mot, longueur, traiter, contexte);
+}
+/**
+* @brief Donne la place occupée par l'automate
+* @param[in] g: L'automate
+* @return Le nombre d'octets des arcs
+*/
+unsigned int tailleDawg(const Dawg& g) {
+	return g.nbArcs * (unsigned int)sizeof(unsigned int);
+}
+/**
+* @brief Libère la mémoire de l'automate
+* @param[in,out] g: L'automate à détruire
+*/
+void detruireDawg(Dawg& g) {
+	delete[] g.arcs;
+	g.arcs = nullptr;
+	g.nbArcs = 0;
+	g.racine = 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#ifndef _DAWG_
+#define _DAWG_
+
+/**
+ * @file dawg.h
+ * @brief Entête du composant automate minimal (DAWG) des mots du dictionnaire
+ */
+
+#include "dico.h"
+
+ /**
+ * @brief Découpage d'un arc de l'automate, rangé dans un entier de 32 bits
+ */
+enum {
+	ARC_LETTRE = 0xFF, // Lettre portée par l'arc
+	ARC_DERNIER = 0x100, // Dernier arc de l'état
+	ARC_MOT = 0x200, // Le préfixe lu en suivant l'arc est un mot
+	ARC_DECALAGE = 10, // Position de l'état d'arrivée dans l'arc
+	ARC_MAX_CIBLE = 0x3FFFFF, // Plus grand indice d'état représentable
+};
+
+/**
+* @brief Automate minimal des mots : les suffixes communs ne sont rangés qu'une fois
+* @note Un état est l'indice de son premier arc, ses arcs se suivent jusqu'à celui marqué ARC_DERNIER.
+* L'état 0 n'a aucun arc.
+* Le jeu ne s'en sert pas : ses robots lisent dans l'arbre des préfixes le nombre de mots de chaque préfixe
+* et la plage de ses mots dans le dictionnaire, que l'automate ne garde pas. bench compare sa taille aux autres représentations.
+*/
+struct Dawg {
+	unsigned int* arcs;
+	unsigned int nbArcs;
+	unsigned int racine; // État du préfixe vide
+};
+
+/**
+* @brief Construit l'automate minimal à partir de l'arbre des préfixes d'un dictionnaire
+* @param[out] g: L'automate à construire
+* @param[in] d: Le dictionnaire, dont l'arbre est construit
+* @return Faux si l'automate a trop d'arcs pour être représenté
+* @see construireArbre, detruireDawg
+*/
+bool construireDawg(Dawg& g, const Dico& d);
+/**
+* @brief Vérifie si un mot est reconnu par l'automate
+* @param[in] g: L'automate
+* @param[in] mot: Le mot à vérifier
+* @return Vrai si le mot est un mot du dictionnaire, faux sinon
+*/
+bool dawgContient(const Dawg& g, const char* mot);
+/**
+* @brief Parcourt par ordre alphabétique les mots qui commencent par un préfixe
+* @param[in] g: L'automate
+* @param[in] prefixe: Le préfixe, terminé par '\0'
+* @param[in] traiter: Fonction appelée pour chaque mot, nullptr pour seulement compter
+* @param[in,out] contexte: Donnée transmise à traiter
+* @return Le nombre de mots qui commencent par le préfixe
+*/
+unsigned int enumererDawg(const Dawg& g, const char* prefixe, void (*traiter)(const char* mot, void* contexte), void* contexte);
+/**
+* @brief Donne la place occupée par l'automate
+* @param[in] g: L'automate
+* @return Le nombre d'octets des arcs
+*/
+unsigned int tailleDawg(const Dawg& g);
+/**
+* @brief Libère la mémoire de l'automate
+* @param[in,out] g: L'automate à détruire
+*/
+void detruireDawg(Dawg& g);
+
+
+#endif // !_DAWG_
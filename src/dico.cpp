@@ -0,0 +1,593 @@
+/**
+ * @file dico.cpp
+ * @brief Composant dictionnaire : chargement, projection en mémoire et format binaire
+ */
+
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <climits>
+#include <cctype>
+#include <new>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "dico.h"
+#include "table.h"
+
+#pragma warning(disable:4996)
+
+using namespace std;
+
+/**
+* @brief Remet un dictionnaire à vide, sans rien libérer
+* @param[out] d: Le dictionnaire
+*/
+static void viderDico(Dico& d) {
+	d.zone = nullptr;
+	d.indices = nullptr;
+	d.nbMot = 0;
+	d.projection = nullptr;
+	d.tailleProjection = 0;
+	d.somme = 0;
+	d.indicesProjetes = false;
+	d.noeuds = nullptr;
+	d.nbNoeuds = 0;
+	d.arbreProjete = false;
+	d.cases = nullptr;
+	d.cles = nullptr;
+	d.rangs = nullptr;
+	d.filtre = nullptr;
+	d.nbBlocs = 0;
+	d.table = nullptr;
+	d.masqueTable = 0;
+	d.tableProjetee = false;
+}
+/**
+* @brief Projette un fichier entier en mémoire, en lecture seule
+* @param[in] chemin: Le chemin du fichier
+* @param[out] taille: La taille du fichier
+* @return Le début de la projection, nullptr si le fichier est absent, vide ou trop gros
+*/
+const char* projeterFichier(const char* chemin, unsigned int& taille) {
+	// Les pages sont partagées par tous les processus qui projettent le même fichier
+#ifdef _WIN32
+	HANDLE fichier = CreateFileA(chemin, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fichier == INVALID_HANDLE_VALUE) return nullptr;
+	LARGE_INTEGER tailleFichier;
+	if (!GetFileSizeEx(fichier, &tailleFichier) || tailleFichier.QuadPart == 0 || tailleFichier.QuadPart >= UINT_MAX) {
+		CloseHandle(fichier);
+		return nullptr;
+	}
+	HANDLE projection = CreateFileMappingA(fichier, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(fichier);
+	if (projection == NULL) return nullptr;
+	const char* debut = (const char*)MapViewOfFile(projection, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(projection);
+	if (debut == NULL) return nullptr;
+	taille = (unsigned int)tailleFichier.QuadPart;
+	return debut;
+#else
+	int fichier = open(chemin, O_RDONLY);
+	if (fichier < 0) return nullptr;
+	struct stat infos;
+	if (fstat(fichier, &infos) != 0 || infos.st_size == 0 || (unsigned long long)infos.st_size >= UINT_MAX) {
+		close(fichier);
+		return nullptr;
+	}
+	void* projection = mmap(nullptr, (size_t)infos.st_size, PROT_READ, MAP_SHARED, fichier, 0);
+	close(fichier);
+	if (projection == MAP_FAILED) return nullptr;
+	taille = (unsigned int)infos.st_size;
+	return (const char*)projection;
+#endif
+}
+/**
+* @brief Libère une projection faite par projeterFichier
+* @param[in] debut: Le début de la projection
+* @param[in] taille: La taille du fichier projeté
+*/
+void libererProjection(const char* debut, unsigned int taille) {
+#ifdef _WIN32
+	(void)taille;
+	UnmapViewOfFile(debut);
+#else
+	munmap((void*)debut, taille);
+#endif
+}
+/**
+* @brief Calcule la somme de contrôle d'un bloc du fichier binaire
+* @param[in] debut: Le début du bloc
+* @param[in] taille: La taille du bloc, multiple de 4
+* @return La somme de contrôle (FNV-1a sur des mots de 32 bits, en quatre suites entrelacées)
+*/
+static unsigned int sommeControle(const char* debut, unsigned int taille) {
+	// Quatre sommes indépendantes avancent ensemble : chacune attend moins la multiplication de la précédente
+	unsigned int sommes[4] = { 2166136261u, 2166136261u, 2166136261u, 2166136261u };
+	unsigned int i = 0;
+	for (; i + 16 <= taille; i += 16) {
+		for (unsigned int k = 0; k < 4; ++k) {
+			unsigned int mot;
+			memcpy(&mot, debut + i + 4 * k, 4);
+			sommes[k] = (sommes[k] ^ mot) * 16777619u;
+		}
+	}
+	for (; i < taille; i += 4) {
+		unsigned int mot;
+		memcpy(&mot, debut + i, 4);
+		sommes[0] = (sommes[0] ^ mot) * 16777619u;
+	}
+	unsigned int somme = sommes[0];
+	for (unsigned int k = 1; k < 4; ++k) somme = (somme ^ sommes[k]) * 16777619u;
+	return somme;
+}
+/**
+* @brief Charge un fichier de mots en une seule lecture dans une zone contiguë
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier de mots (triés, un par ligne)
+* @return Vrai si le fichier a pu être lu, faux sinon
+* @see detruireDico
+*/
+bool chargerDico(Dico& d, const char* chemin) {
+	viderDico(d);
+
+	//Ouverture du dico
+	ifstream dico(chemin, ios::binary);
+	if (!dico.good()) return false;
+
+	//Taille du fichier
+	dico.seekg(0, ios::end);
+	streamoff taille = dico.tellg();
+	dico.seekg(0, ios::beg);
+	if (taille < 0) return false;
+
+	// Lecture de tout le fichier d'un coup dans la zone
+	char* zone = new char[(size_t)taille + 1];
+	dico.read(zone, taille);
+	taille = dico.gcount();
+	dico.close();
+
+	// On remplace les séparateurs par des '\0' en tassant les mots au début de la zone,
+	// un mot trop long est coupé tous les MAX - 1 caractères comme le faisait setw(MAX)
+	unsigned int ecrit = 0;
+	unsigned int longueur = 0;
+	for (streamoff i = 0; i < taille; ++i) {
+		char c = zone[i];
+		if (isspace((unsigned char)c)) {
+			if (longueur > 0) {
+				zone[ecrit++] = '\0';
+				d.nbMot++;
+				longueur = 0;
+			}
+		}
+		else {
+			if (longueur == MAX - 1) {
+				zone[ecrit++] = '\0';
+				d.nbMot++;
+				longueur = 0;
+			}
+			zone[ecrit++] = c;
+			longueur++;
+		}
+	}
+	if (longueur > 0) {
+		zone[ecrit++] = '\0';
+		d.nbMot++;
+	}
+	d.zone = zone;
+
+	// Table des positions de chaque mot dans la zone
+	unsigned int* indices = new unsigned int[d.nbMot];
+	unsigned int debut = 0;
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		indices[i] = debut;
+		debut += (unsigned int)strlen(zone + debut) + 1;
+	}
+	d.indices = indices;
+	return true;
+}
+/**
+* @brief Projette un fichier de mots en mémoire (lecture seule) et indexe les mots sur place, sans les copier
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier de mots (triés, un par ligne)
+* @return Vrai si le fichier a pu être projeté, faux sinon (il faut alors utiliser chargerDico)
+* @see detruireDico
+*/
+bool projeterDico(Dico& d, const char* chemin) {
+	viderDico(d);
+
+	unsigned int taille = 0;
+	const char* zone = projeterFichier(chemin, taille);
+	if (zone == nullptr) return false;
+	d.zone = zone;
+	d.projection = zone;
+	d.tailleProjection = taille;
+
+	// Les mots restent dans le fichier, terminés par leur fin de ligne. Le dernier caractère
+	// doit donc être un séparateur, et un mot trop long ne peut pas être coupé sur place
+	bool valide = estFinMot(zone[taille - 1]);
+	unsigned int longueur = 0;
+	for (unsigned int i = 0; i < taille && valide; ++i) {
+		if (estFinMot(zone[i])) longueur = 0;
+		else {
+			if (longueur == 0) d.nbMot++;
+			if (++longueur == MAX) valide = false;
+		}
+	}
+	if (!valide) {
+		detruireDico(d);
+		return false;
+	}
+
+	// Table des positions de chaque mot dans le fichier
+	unsigned int* indices = new unsigned int[d.nbMot];
+	unsigned int n = 0;
+	for (unsigned int i = 0; i < taille; ++i) {
+		if (!estFinMot(zone[i]) && (i == 0 || estFinMot(zone[i - 1]))) {
+			indices[n++] = i;
+		}
+	}
+	d.indices = indices;
+	return true;
+}
+/**
+* @brief Compile un fichier de mots en dictionnaire binaire
+* @param[in] source: Le chemin du fichier de mots
+* @param[in] destination: Le chemin du fichier binaire à écrire
+* @return Vrai si le fichier binaire a été écrit, faux sinon
+* @see chargerDicoBinaire
+*/
+bool compilerDico(const char* source, const char* destination) {
+	struct stat infos;
+	if (stat(source, &infos) != 0) return false;
+
+	Dico d;
+	if (!chargerDico(d, source)) return false;
+
+	// Les mots sont recopiés tassés, terminés par '\0', la zone est complétée jusqu'à un multiple de 4
+	unsigned int tailleMots = 0;
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		tailleMots += longueurMot(motDico(d, i)) + 1;
+	}
+	tailleMots = (tailleMots + 3) / 4 * 4;
+
+	// L'arbre, le filtre et la table sont construits une fois pour toutes ici, le jeu les projette avec les mots.
+	// Le filtre commence sur une ligne de cache, comme celui que construit construireTable
+	construireArbre(d);
+	construireTable(d);
+	unsigned long long tailleArbre = (unsigned long long)d.nbNoeuds * sizeof(Noeud);
+	unsigned long long tailleFiltre = (unsigned long long)d.nbBlocs * TAILLE_BLOC_FILTRE;
+	unsigned long long tailleHachage = 2 * ((unsigned long long)d.masqueTable + 1) * sizeof(unsigned int);
+	unsigned int tailleTable = d.nbMot * (unsigned int)sizeof(unsigned int);
+	unsigned long long finArbre = sizeof(EnteteDico) + tailleTable + tailleMots + tailleArbre;
+	unsigned long long remplissage = (ALIGNEMENT_CLES - finArbre % ALIGNEMENT_CLES) % ALIGNEMENT_CLES;
+	if (finArbre + remplissage + tailleFiltre + tailleHachage >= UINT_MAX) {
+		detruireDico(d);
+		return false;
+	}
+	unsigned int tailleCorps = (unsigned int)(finArbre + remplissage + tailleFiltre + tailleHachage - sizeof(EnteteDico));
+	char* corps = new char[tailleCorps];
+	unsigned int* indices = (unsigned int*)corps;
+	char* mots = corps + tailleTable;
+	memset(mots, 0, tailleMots);
+	unsigned int position = 0;
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		unsigned int longueur = longueurMot(motDico(d, i));
+		indices[i] = position;
+		memcpy(mots + position, motDico(d, i), longueur);
+		position += longueur + 1;
+	}
+	char* suite = corps + tailleTable + tailleMots;
+	memcpy(suite, d.noeuds, (size_t)tailleArbre);
+	suite += tailleArbre;
+	memset(suite, 0, (size_t)remplissage);
+	suite += remplissage;
+	memcpy(suite, d.filtre, (size_t)tailleFiltre);
+	memcpy(suite + tailleFiltre, d.table, (size_t)tailleHachage);
+
+	EnteteDico entete;
+	memset(&entete, 0, sizeof(entete));
+	memcpy(entete.magique, "SINGEDIC", 8);
+	entete.version = VERSION_DICO;
+	entete.nbMot = d.nbMot;
+	entete.tailleMots = tailleMots;
+	entete.somme = sommeControle(corps, tailleCorps);
+	entete.nbNoeuds = d.nbNoeuds;
+	entete.nbBlocs = d.nbBlocs;
+	entete.masqueTable = d.masqueTable;
+	entete.tailleSource = (unsigned long long)infos.st_size;
+	entete.dateSource = (long long)infos.st_mtime;
+	detruireDico(d);
+
+	// Le fichier est écrit à côté puis renommé : un processus qui projette encore l'ancien le garde intact
+	string provisoire = string(destination) + ".tmp";
+	ofstream fichier(provisoire.c_str(), ios::binary | ios::trunc);
+	fichier.write((const char*)&entete, sizeof(entete));
+	fichier.write(corps, tailleCorps);
+	delete[] corps;
+	fichier.close();
+	if (!fichier.good()) {
+		remove(provisoire.c_str());
+		return false;
+	}
+#ifdef _WIN32
+	remove(destination); // rename ne remplace pas un fichier existant
+#endif
+	return rename(provisoire.c_str(), destination) == 0;
+}
+/**
+* @brief Charge un dictionnaire binaire en le projetant en mémoire, sans analyser le texte
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier binaire
+* @param[in] source: Le chemin du fichier de mots dont il est issu, nullptr pour ne pas le vérifier
+* @return Faux si le fichier est absent, d'une autre version, corrompu ou plus ancien que source
+* @see compilerDico, detruireDico
+*/
+bool chargerDicoBinaire(Dico& d, const char* chemin, const char* source) {
+	viderDico(d);
+
+	unsigned int taille = 0;
+	const char* debut = projeterFichier(chemin, taille);
+	if (debut == nullptr) return false;
+
+	EnteteDico entete;
+	unsigned long long finArbre = 0, remplissage = 0;
+	bool valide = taille >= sizeof(entete);
+	if (valide) {
+		memcpy(&entete, debut, sizeof(entete));
+		finArbre = sizeof(entete) + (unsigned long long)entete.nbMot * sizeof(unsigned int) + entete.tailleMots
+			+ (unsigned long long)entete.nbNoeuds * sizeof(Noeud);
+		remplissage = (ALIGNEMENT_CLES - finArbre % ALIGNEMENT_CLES) % ALIGNEMENT_CLES;
+		valide = memcmp(entete.magique, "SINGEDIC", 8) == 0 && entete.version == VERSION_DICO
+			&& entete.tailleMots % 4 == 0
+			&& entete.nbNoeuds > 0
+			&& entete.nbBlocs > 0 && (entete.nbBlocs & (entete.nbBlocs - 1)) == 0
+			&& (entete.masqueTable & (entete.masqueTable + 1)) == 0
+			&& (unsigned long long)taille == finArbre + remplissage + (unsigned long long)entete.nbBlocs * TAILLE_BLOC_FILTRE
+			+ 2 * ((unsigned long long)entete.masqueTable + 1) * sizeof(unsigned int);
+	}
+
+	// Le fichier texte a changé depuis la compilation (s'il est absent, le binaire fait foi)
+	struct stat infos;
+	if (valide && source != nullptr && stat(source, &infos) == 0) {
+		valide = entete.tailleSource == (unsigned long long)infos.st_size && entete.dateSource == (long long)infos.st_mtime;
+	}
+
+	if (valide) {
+		valide = sommeControle(debut + sizeof(entete), taille - (unsigned int)sizeof(entete)) == entete.somme;
+	}
+	if (!valide) {
+		libererProjection(debut, taille);
+		return false;
+	}
+
+	d.projection = debut;
+	d.tailleProjection = taille;
+	d.somme = entete.somme;
+	d.nbMot = entete.nbMot;
+	d.indices = (const unsigned int*)(debut + sizeof(entete));
+	d.indicesProjetes = true;
+	d.zone = debut + sizeof(entete) + entete.nbMot * sizeof(unsigned int);
+	d.noeuds = (const Noeud*)(d.zone + entete.tailleMots);
+	d.nbNoeuds = entete.nbNoeuds;
+	d.arbreProjete = true;
+	d.filtre = (const unsigned long long*)(debut + finArbre + remplissage);
+	d.nbBlocs = entete.nbBlocs;
+	d.table = (const unsigned int*)(debut + finArbre + remplissage + (unsigned long long)entete.nbBlocs * TAILLE_BLOC_FILTRE);
+	d.masqueTable = entete.masqueTable;
+	d.tableProjetee = true;
+	return true;
+}
+/**
+* @brief Donne le chemin du dictionnaire binaire d'un fichier de mots, celui où compilDico l'écrit par défaut :
+* le chemin du fichier de mots, son extension remplacée par .bin
+* @param[in] chemin: Le chemin du fichier de mots
+* @return Le chemin du fichier binaire, alloué par new[] et à libérer par delete[]
+* @see compilerDico, chargerDicoBinaire
+*/
+char* cheminBinaire(const char* chemin) {
+	// L'extension est le dernier point du nom du fichier, pas d'un répertoire, et pas celui qui commence le nom
+	unsigned int longueur = (unsigned int)strlen(chemin);
+	unsigned int nom = longueur;
+	while (nom > 0 && chemin[nom - 1] != '/' && chemin[nom - 1] != '\\') --nom;
+	unsigned int fin = longueur;
+	for (unsigned int i = nom + 1; i < longueur; ++i) {
+		if (chemin[i] == '.') fin = i;
+	}
+
+	char* binaire = new char[fin + sizeof(".bin")];
+	memcpy(binaire, chemin, fin);
+	strcpy(binaire + fin, ".bin");
+	return binaire;
+}
+/**
+* @brief Compare le début d'un mot du dictionnaire à un préfixe, comme strncmp
+* @param[in] motDico: Le mot du dictionnaire
+* @param[in] prefixe: Le préfixe
+* @param[in] longueur: La longueur du préfixe
+* @return Négatif si le mot est avant le préfixe, nul s'il commence par le préfixe, positif s'il est après
+*/
+static int comparerPrefixe(const char* motDico, const char* prefixe, unsigned int longueur) {
+	for (unsigned int i = 0; i < longueur; ++i) {
+		if (estFinMot(motDico[i])) return -1;
+		if (motDico[i] != prefixe[i]) return (int)(unsigned char)motDico[i] - (int)(unsigned char)prefixe[i];
+	}
+	return 0;
+}
+/**
+* @brief Cherche les mots qui commencent par un préfixe, par deux recherches dichotomiques
+* @param[in] d: Le dictionnaire, trié
+* @param[in] prefixe: Le préfixe cherché, terminé par '\0'
+* @param[out] debut: L'indice du premier mot qui commence par le préfixe
+* @param[out] fin: L'indice qui suit le dernier mot qui commence par le préfixe
+* @note Aucun mot ne commence par le préfixe si debut == fin
+*/
+void intervallePrefixe(const Dico& d, const char* prefixe, unsigned int& debut, unsigned int& fin) {
+	unsigned int longueur = (unsigned int)strlen(prefixe);
+
+	// Premier mot qui n'est pas avant le préfixe
+	unsigned int min = 0, max = d.nbMot;
+	while (min < max) {
+		unsigned int milieu = min + (max - min) / 2;
+		if (comparerPrefixe(motDico(d, milieu), prefixe, longueur) < 0) min = milieu + 1;
+		else max = milieu;
+	}
+	debut = min;
+
+	// Premier mot qui est après le préfixe
+	max = d.nbMot;
+	while (min < max) {
+		unsigned int milieu = min + (max - min) / 2;
+		if (comparerPrefixe(motDico(d, milieu), prefixe, longueur) <= 0) min = milieu + 1;
+		else max = milieu;
+	}
+	fin = min;
+}
+/**
+* @brief Remplit un noeud de l'arbre et, récursivement, ses descendants
+* @param[in] d: Le dictionnaire
+* @param[in,out] noeuds: L'arbre en construction
+* @param[in] noeud: L'indice du noeud à remplir
+* @param[in] debut: Le premier mot qui commence par le préfixe du noeud
+* @param[in] fin: L'indice qui suit le dernier mot qui commence par le préfixe du noeud
+* @param[in] profondeur: La longueur du préfixe du noeud
+* @param[in,out] libre: L'indice du premier noeud pas encore utilisé
+*/
+static void remplirNoeud(const Dico& d, Noeud* noeuds, unsigned int noeud, unsigned int debut, unsigned int fin, unsigned int profondeur, unsigned int& libre) {
+	Noeud& n = noeuds[noeud];
+	n.debut = debut;
+	n.nbMots = fin - debut;
+
+	// Le préfixe lui-même, s'il est un mot, est placé avant tous les mots plus longs
+	unsigned int i = debut;
+	while (i < fin && estFinMot(motDico(d, i)[profondeur])) ++i;
+	n.estMot = i > debut;
+
+	// Les fils sont les groupes de mots qui ont la même lettre à cette profondeur
+	unsigned int nbFils = 0;
+	for (unsigned int j = i; j < fin; ++j) {
+		if (j == i || motDico(d, j)[profondeur] != motDico(d, j - 1)[profondeur]) ++nbFils;
+	}
+	n.premierFils = libre;
+	n.nbFils = (unsigned short)nbFils;
+	unsigned int fils = libre;
+	libre += nbFils;
+
+	unsigned int groupe = i;
+	for (unsigned int j = i + 1; j <= fin; ++j) {
+		if (j == fin || motDico(d, j)[profondeur] != motDico(d, groupe)[profondeur]) {
+			noeuds[fils].lettre = motDico(d, groupe)[profondeur];
+			remplirNoeud(d, noeuds, fils, groupe, j, profondeur + 1, libre);
+			++fils;
+			groupe = j;
+		}
+	}
+}
+/**
+* @brief Construit l'arbre des préfixes d'un dictionnaire chargé
+* @param[in,out] d: Le dictionnaire, trié
+* @see detruireDico
+*/
+void construireArbre(Dico& d) {
+	// Un noeud par préfixe distinct : chaque mot ajoute les lettres qu'il ne partage pas avec le précédent
+	unsigned int nbNoeuds = 1;
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		const char* mot = motDico(d, i);
+		unsigned int commun = 0;
+		if (i > 0) {
+			const char* precedent = motDico(d, i - 1);
+			while (!estFinMot(mot[commun]) && mot[commun] == precedent[commun]) ++commun;
+		}
+		nbNoeuds += longueurMot(mot) - commun;
+	}
+
+	if (!d.arbreProjete) delete[] d.noeuds;
+	Noeud* noeuds = new Noeud[nbNoeuds];
+	noeuds[0].lettre = '\0';
+	unsigned int libre = 1;
+	remplirNoeud(d, noeuds, 0, 0, d.nbMot, 0, libre);
+	d.noeuds = noeuds;
+	d.nbNoeuds = nbNoeuds;
+	d.arbreProjete = false;
+}
+/**
+* @brief Cherche le fils d'un noeud de l'arbre qui ajoute une lettre au préfixe
+* @param[in] d: Le dictionnaire
+* @param[in] noeud: L'indice du noeud
+* @param[in] lettre: La lettre ajoutée
+* @return L'indice du fils, AUCUN_NOEUD si aucun mot ne continue par cette lettre
+* @pre l'arbre est construit
+*/
+unsigned int filsNoeud(const Dico& d, unsigned int noeud, char lettre) {
+	const Noeud& n = d.noeuds[noeud];
+	for (unsigned int i = n.premierFils; i < n.premierFils + n.nbFils; ++i) {
+		if (d.noeuds[i].lettre == lettre) return i;
+	}
+	return AUCUN_NOEUD;
+}
+/**
+* @brief Cherche le noeud de l'arbre qui correspond à un préfixe
+* @param[in] d: Le dictionnaire
+* @param[in] prefixe: Le préfixe, terminé par '\0'
+* @return L'indice du noeud, AUCUN_NOEUD si aucun mot ne commence par ce préfixe
+* @pre l'arbre est construit
+*/
+unsigned int noeudPrefixe(const Dico& d, const char* prefixe) {
+	unsigned int noeud = 0;
+	for (unsigned int i = 0; prefixe[i] != '\0' && noeud != AUCUN_NOEUD; ++i) {
+		noeud = filsNoeud(d, noeud, prefixe[i]);
+	}
+	return noeud;
+}
+/**
+* @brief Donne la longueur d'un mot du dictionnaire
+* @param[in] mot: Le mot du dictionnaire
+* @return Le nombre de caractères avant la fin du mot
+* @see estFinMot
+*/
+unsigned int longueurMot(const char* mot) {
+	unsigned int longueur = 0;
+	while (!estFinMot(mot[longueur])) ++longueur;
+	return longueur;
+}
+/**
+* @brief Compare un mot du dictionnaire à un autre mot, comme strcmp
+* @param[in] motDico: Le mot du dictionnaire
+* @param[in] mot: Le mot à comparer (terminé par '\0' ou lui aussi pris dans le dictionnaire)
+* @return Négatif, nul ou positif selon que motDico est avant, égal ou après mot
+*/
+int comparerMot(const char* motDico, const char* mot) {
+	unsigned int i = 0;
+	while (!estFinMot(motDico[i]) && motDico[i] == mot[i]) ++i;
+	unsigned char a = estFinMot(motDico[i]) ? '\0' : (unsigned char)motDico[i];
+	unsigned char b = estFinMot(mot[i]) ? '\0' : (unsigned char)mot[i];
+	return (int)a - (int)b;
+}
+/**
+* @brief Libère la mémoire d'un dictionnaire
+* @param[in,out] d: Le dictionnaire à détruire
+*/
+void detruireDico(Dico& d) {
+	if (d.projection != nullptr) libererProjection(d.projection, d.tailleProjection);
+	else delete[] d.zone;
+	if (!d.indicesProjetes) delete[] d.indices;
+	if (!d.arbreProjete) delete[] d.noeuds;
+	if (d.cases != nullptr) ::operator delete[](d.cases, align_val_t(TAILLE_CASE));
+	if (d.cles != nullptr) ::operator delete[](d.cles, align_val_t(ALIGNEMENT_CLES));
+	delete[] d.rangs;
+	if (!d.tableProjetee) {
+		if (d.filtre != nullptr) ::operator delete[]((void*)d.filtre, align_val_t(ALIGNEMENT_CLES));
+		delete[] d.table;
+	}
+	viderDico(d);
+}
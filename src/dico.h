@@ -0,0 +1,201 @@
+#pragma once
+
+#ifndef _DICO_
+#define _DICO_
+
+/**
+ * @file dico.h
+ * @brief Entête du composant dictionnaire
+ */
+
+ /**
+ * @brief Les constantes du dictionnaire
+ */
+enum {
+	MAX = 28, // Taille maximale d'un mot, '\0' compris
+	VERSION_DICO = 3, // Version du format binaire du dictionnaire
+	AUCUN_NOEUD = 0xFFFFFFFF, // Préfixe absent de l'arbre
+	TAILLE_CASE = 32, // Place d'un mot rangé dans une case, '\0' de fin et de remplissage compris
+	ALIGNEMENT_CLES = 64, // Les clés de l'index de Eytzinger et les blocs du filtre de Bloom commencent sur une ligne de cache
+	TAILLE_BLOC_FILTRE = 64, // Octets d'un bloc du filtre de Bloom
+};
+
+/**
+* @brief Noeud de l'arbre des préfixes du dictionnaire
+*/
+struct Noeud {
+	unsigned int premierFils; // Indice du premier fils, les fils d'un noeud se suivent par ordre alphabétique
+	unsigned int debut; // Indice du premier mot du dico qui commence par ce préfixe
+	unsigned int nbMots; // Nombre de mots qui commencent par ce préfixe (lui compris)
+	unsigned short nbFils;
+	char lettre; // Dernière lettre du préfixe
+	bool estMot; // Vrai si le préfixe est lui-même un mot du dico
+};
+/**
+* @brief Structure de données de type Dico
+*/
+struct Dico {
+	const char* zone; // Tous les mots du dictionnaire, à la suite
+	const unsigned int* indices; // Position de chaque mot dans la zone
+	unsigned int nbMot;
+	const char* projection; // Début du fichier projeté en mémoire, nullptr si la zone est allouée
+	unsigned int tailleProjection;
+	unsigned int somme; // Somme de contrôle du fichier binaire projeté, 0 si le dictionnaire vient du texte
+	bool indicesProjetes; // Vrai si la table des positions fait partie du fichier projeté
+	const Noeud* noeuds; // Arbre des préfixes, la racine (préfixe vide) est le noeud 0
+	unsigned int nbNoeuds;
+	bool arbreProjete; // Vrai si l'arbre fait partie du fichier projeté
+	char* cases; // Mots rangés dans des cases de TAILLE_CASE octets alignées, nullptr si elles ne sont pas construites (seul bench les construit)
+	unsigned long long* cles; // Index de Eytzinger : huit premiers octets des mots, nullptr s'il n'est pas construit (seul bench le construit)
+	unsigned int* rangs; // Indice dans le dico du mot de chaque clé de l'index
+	const unsigned long long* filtre; // Filtre de Bloom par blocs de 64 octets, nullptr si la table n'est pas construite
+	unsigned int nbBlocs; // Puissance de 2
+	const unsigned int* table; // Table de hachage : par case, 32 bits du hachage puis l'indice du mot + 1 (0 si la case est vide)
+	unsigned int masqueTable; // Nombre de cases - 1
+	bool tableProjetee; // Vrai si le filtre et la table font partie du fichier projeté
+};
+/**
+* @brief Entête du fichier binaire du dictionnaire, suivi de la table des positions, des mots, de l'arbre des préfixes,
+* puis, à partir d'une ligne de cache, du filtre de Bloom et de la table de hachage
+*/
+struct EnteteDico {
+	char magique[8]; // "SINGEDIC"
+	unsigned int version;
+	unsigned int nbMot;
+	unsigned int tailleMots; // Taille de la zone des mots, multiple de 4
+	unsigned int somme; // Somme de contrôle de tout ce qui suit l'entête
+	unsigned int nbNoeuds; // Noeuds de l'arbre des préfixes
+	unsigned int nbBlocs; // Blocs du filtre de Bloom
+	unsigned int masqueTable; // Cases de la table de hachage - 1
+	unsigned long long tailleSource; // Taille du fichier texte compilé
+	long long dateSource; // Date de modification du fichier texte compilé
+};
+
+/**
+* @brief Vérifie si un caractère termine un mot du dictionnaire
+* @param[in] c: Le caractère à vérifier
+* @return Vrai pour '\0' et les séparateurs (espace, fin de ligne), faux sinon
+*/
+inline bool estFinMot(char c) {
+	return (unsigned char)c <= ' ';
+}
+/**
+* @brief Donne le mot d'indice i du dictionnaire
+* @param[in] d: Le dictionnaire
+* @param[in] i: L'indice du mot
+* @return Le mot, terminé par un caractère vérifiant estFinMot
+* @pre i < d.nbMot
+*/
+inline const char* motDico(const Dico& d, unsigned int i) {
+	return d.zone + d.indices[i];
+}
+/**
+* @brief Charge un fichier de mots en une seule lecture dans une zone contiguë
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier de mots (triés, un par ligne)
+* @return Vrai si le fichier a pu être lu, faux sinon
+* @see detruireDico
+*/
+bool chargerDico(Dico& d, const char* chemin);
+/**
+* @brief Projette un fichier de mots en mémoire (lecture seule) et indexe les mots sur place, sans les copier
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier de mots (triés, un par ligne)
+* @return Vrai si le fichier a pu être projeté, faux sinon (il faut alors utiliser chargerDico)
+* @see detruireDico
+*/
+bool projeterDico(Dico& d, const char* chemin);
+/**
+* @brief Compile un fichier de mots en dictionnaire binaire
+* @param[in] source: Le chemin du fichier de mots
+* @param[in] destination: Le chemin du fichier binaire à écrire
+* @return Vrai si le fichier binaire a été écrit, faux sinon
+* @see chargerDicoBinaire
+*/
+bool compilerDico(const char* source, const char* destination);
+/**
+* @brief Charge un dictionnaire binaire en le projetant en mémoire, sans analyser le texte
+* @param[out] d: Le dictionnaire à remplir
+* @param[in] chemin: Le chemin du fichier binaire
+* @param[in] source: Le chemin du fichier de mots dont il est issu, nullptr pour ne pas le vérifier
+* @return Faux si le fichier est absent, d'une autre version, corrompu ou plus ancien que source
+* @see compilerDico, detruireDico
+*/
+bool chargerDicoBinaire(Dico& d, const char* chemin, const char* source);
+/**
+* @brief Donne le chemin du dictionnaire binaire d'un fichier de mots, celui où compilDico l'écrit par défaut :
+* le chemin du fichier de mots, son extension remplacée par .bin
+* @param[in] chemin: Le chemin du fichier de mots
+* @return Le chemin du fichier binaire, alloué par new[] et à libérer par delete[]
+* @see compilerDico, chargerDicoBinaire
+*/
+char* cheminBinaire(const char* chemin);
+/**
+* @brief Projette un fichier entier en mémoire, en lecture seule
+* @param[in] chemin: Le chemin du fichier
+* @param[out] taille: La taille du fichier
+* @return Le début de la projection, nullptr si le fichier est absent, vide ou trop gros
+* @see libererProjection
+*/
+const char* projeterFichier(const char* chemin, unsigned int& taille);
+/**
+* @brief Libère une projection faite par projeterFichier
+* @param[in] debut: Le début de la projection
+* @param[in] taille: La taille du fichier projeté
+*/
+void libererProjection(const char* debut, unsigned int taille);
+/**
+* @brief Cherche les mots qui commencent par un préfixe, par deux recherches dichotomiques
+* @param[in] d: Le dictionnaire, trié
+* @param[in] prefixe: Le préfixe cherché, terminé par '\0'
+* @param[out] debut: L'indice du premier mot qui commence par le préfixe
+* @param[out] fin: L'indice qui suit le dernier mot qui commence par le préfixe
+* @note Aucun mot ne commence par le préfixe si debut == fin
+*/
+void intervallePrefixe(const Dico& d, const char* prefixe, unsigned int& debut, unsigned int& fin);
+/**
+* @brief Construit l'arbre des préfixes d'un dictionnaire chargé
+* @param[in,out] d: Le dictionnaire, trié
+* @note Inutile pour un dictionnaire binaire : son arbre est projeté avec les mots
+* @see detruireDico
+*/
+void construireArbre(Dico& d);
+/**
+* @brief Cherche le fils d'un noeud de l'arbre qui ajoute une lettre au préfixe
+* @param[in] d: Le dictionnaire
+* @param[in] noeud: L'indice du noeud
+* @param[in] lettre: La lettre ajoutée
+* @return L'indice du fils, AUCUN_NOEUD si aucun mot ne continue par cette lettre
+* @pre l'arbre est construit
+*/
+unsigned int filsNoeud(const Dico& d, unsigned int noeud, char lettre);
+/**
+* @brief Cherche le noeud de l'arbre qui correspond à un préfixe
+* @param[in] d: Le dictionnaire
+* @param[in] prefixe: Le préfixe, terminé par '\0'
+* @return L'indice du noeud, AUCUN_NOEUD si aucun mot ne commence par ce préfixe
+* @pre l'arbre est construit
+*/
+unsigned int noeudPrefixe(const Dico& d, const char* prefixe);
+/**
+* @brief Donne la longueur d'un mot du dictionnaire
+* @param[in] mot: Le mot du dictionnaire
+* @return Le nombre de caractères avant la fin du mot
+* @see estFinMot
+*/
+unsigned int longueurMot(const char* mot);
+/**
+* @brief Compare un mot du dictionnaire à un autre mot, comme strcmp
+* @param[in] motDico: Le mot du dictionnaire
+* @param[in] mot: Le mot à comparer (terminé par '\0' ou lui aussi pris dans le dictionnaire)
+* @return Négatif, nul ou positif selon que motDico est avant, égal ou après mot
+*/
+int comparerMot(const char* motDico, const char* mot);
+/**
+* @brief Libère la mémoire d'un dictionnaire
+* @param[in,out] d: Le dictionnaire à détruire
+*/
+void detruireDico(Dico& d);
+
+
+#endif // !_DICO_
@@ -0,0 +1,84 @@
+/**
+ * @file eytzinger.cpp
+ * @brief Composant index de recherche des mots rangé dans l'ordre de Eytzinger
+ *
+ * Le noeud k de l'arbre a pour fils 2k et 2k + 1 : une descente lit des cases de plus en plus éloignées mais prévisibles,
+ * et les huit clés des petits-petits-enfants d'un noeud tiennent dans une seule ligne de cache, chargée à l'avance.
+ * Chaque clé range les huit premiers octets du mot de façon que l'ordre des entiers soit celui des mots :
+ * la zone des mots n'est lue que si la clé cherchée et celle du noeud sont égales.
+ * Seul bench construit l'index, pour le comparer à la table dans laquelle le jeu cherche les mots.
+ */
+
+#include <new>
+
+#include "eytzinger.h"
+
+using namespace std;
+
+/**
+* @brief Range les huit premiers octets d'un mot dans un entier, le premier dans l'octet de poids fort
+* @param[in] mot: Le mot, terminé par un caractère vérifiant estFinMot
+* @return La clé, complétée par des zéros si le mot est plus court
+*/
+static inline unsigned long long cleMot(const char* mot) {
+	unsigned long long cle = 0;
+	unsigned int i = 0;
+	for (; i < 8 && !estFinMot(mot[i]); ++i) cle = (cle << 8) | (unsigned char)mot[i];
+	return cle << (8 * (8 - i));
+}
+/**
+* @brief Range les mots d'un intervalle dans le sous-arbre d'un noeud, par un parcours infixe
+* @param[in,out] d: Le dictionnaire
+* @param[in] k: Le noeud
+* @param[in,out] suivant: L'indice du prochain mot à ranger
+*/
+static void remplirEytzinger(Dico& d, unsigned int k, unsigned int& suivant) {
+	if (k > d.nbMot) return;
+	remplirEytzinger(d, 2 * k, suivant);
+	d.cles[k] = cleMot(motDico(d, suivant));
+	d.rangs[k] = suivant;
+	++suivant;
+	remplirEytzinger(d, 2 * k + 1, suivant);
+}
+/**
+* @brief Construit l'index : les huit premiers octets de chaque mot, rangés comme un arbre binaire en largeur
+* @param[in,out] d: Le dictionnaire chargé, trié
+* @see detruireDico
+*/
+void construireEytzinger(Dico& d) {
+	// Le noeud 0 n'est pas utilisé : la racine est le noeud 1
+	d.cles = static_cast<unsigned long long*>(::operator new[](((size_t)d.nbMot + 1) * sizeof(unsigned long long), align_val_t(ALIGNEMENT_CLES)));
+	d.rangs = new unsigned int[d.nbMot + 1];
+	d.cles[0] = 0;
+	d.rangs[0] = 0;
+	unsigned int suivant = 0;
+	remplirEytzinger(d, 1, suivant);
+}
+/**
+* @brief Vérifie si un mot est dans le dictionnaire, en descendant l'index
+* @param[in] d: Le dictionnaire, dont l'index est construit
+* @param[in] mot: Le mot à chercher, terminé par '\0'
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherEytzinger(const Dico& d, const char* mot) {
+	unsigned long long cle = cleMot(mot);
+	bool court = (cle & 0xFF) == 0; // Moins de huit lettres : la clé suffit à comparer
+
+	// On descend à droite tant que le noeud est avant le mot : à la sortie, k code le chemin du premier noeud qui ne l'est pas
+	unsigned int k = 1;
+	while (k <= d.nbMot) {
+#if defined(__GNUC__)
+		__builtin_prefetch(d.cles + 8 * (size_t)k);
+#endif
+		unsigned long long c = d.cles[k];
+		unsigned int avant = c < cle;
+		// Clés égales : rare, seulement tout près du mot cherché, ce test est bien prédit
+		if (c == cle && !court) avant = comparerMot(motDico(d, d.rangs[k]) + 8, mot + 8) < 0;
+		k = 2 * k + avant;
+	}
+	// On remonte les derniers pas à droite, plus le dernier à gauche
+	while (k & 1) k >>= 1;
+	k >>= 1;
+	if (k == 0 || d.cles[k] != cle) return false;
+	return court || comparerMot(motDico(d, d.rangs[k]) + 8, mot + 8) == 0;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#ifndef _EYTZINGER_
+#define _EYTZINGER_
+
+/**
+ * @file eytzinger.h
+ * @brief Entête du composant index de recherche des mots rangé dans l'ordre de Eytzinger
+ */
+
+#include "dico.h"
+
+/**
+* @brief Construit l'index : les huit premiers octets de chaque mot, rangés comme un arbre binaire en largeur
+* @param[in,out] d: Le dictionnaire chargé, trié
+* @see detruireDico
+*/
+void construireEytzinger(Dico& d);
+/**
+* @brief Vérifie si un mot est dans le dictionnaire, en descendant l'index
+* @param[in] d: Le dictionnaire, dont l'index est construit
+* @param[in] mot: Le mot à chercher, terminé par '\0'
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherEytzinger(const Dico& d, const char* mot);
+
+
+#endif // !_EYTZINGER_
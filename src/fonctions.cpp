@@ -1,6 +1,6 @@
 /**
  * @file fonctions.cpp
- * @brief Entte du composant de fonctions
+ * @brief Entête du composant de fonctions
  */
 
 #include <iostream>
@@ -8,42 +8,47 @@
 #include <iomanip>
 #include <locale>
 #include <cstring>
+#include <climits>
 
 #include "fonctions.h"
+#include "table.h"
+#include "registre.h"
+#include "statistiques.h"
+#include "montecarlo.h"
 
 #pragma warning(disable:4996,6385)
 
 using namespace std;
 
 /**
-* @brief Vrification du nombre de joueur
-* @param[in] argv : L'argument utilis pour compter le nombre de joueur
-* @return retourne un boolan
+* @brief Vérification du nombre de joueur
+* @param[in] argv : L'argument utilisé pour compter le nombre de joueur
+* @return retourne un booléan
 * @pre argv valide
 */
 bool verifNbJoueur(const char* argv[]) {
-	// Vrifier que le tableau d'arguments contient au moins un lment
+	// Vérifier que le tableau d'arguments contient au moins un élément
 	if (argv == nullptr || argv[0] == nullptr) {
 		return false;
 	}
 
 	const char* param = argv[1];
 
-	// Vrifier que la chane de caractres reprsentant le nombre de joueurs est de longueur minimale MIN_JOUEURS
-	if (param == nullptr || strlen(param) < MIN_JOUEURS) {
+	// Vérifier que la chaîne de caractères représentant le nombre de joueurs a une longueur de MIN_JOUEURS à MAX_JOUEURS
+	if (param == nullptr || strlen(param) < MIN_JOUEURS || strlen(param) > MAX_JOUEURS) {
 		return false;
 	}
 
 	return true;
 }
 /**
-* @brief Vrifie le type de joueur
-* @param[in] argv : L'argument utilis pour vrifier le type de joueur
-* @return Retourne un boolen
-* @pre argv doit tre valide
+* @brief Vérifie le type de joueur
+* @param[in] argv : L'argument utilisé pour vérifier le type de joueur
+* @return Retourne un booléen
+* @pre argv doit être valide
 */
 bool verifJoueur(const char* argv[]) {
-	// Vrifier que le tableau d'arguments contient au moins un lment
+	// Vérifier que le tableau d'arguments contient au moins un élément
 	if (argv == nullptr || argv[0] == nullptr) {
 		return false;
 	}
@@ -51,15 +56,15 @@ bool verifJoueur(const char* argv[]) {
 	const char* param = argv[1];
 	char type;
 
-	// Vrifier que la chane de caractres reprsentant le type de joueurs n'est pas vide
+	// Vérifier que la chaîne de caractères représentant le type de joueurs n'est pas vide
 	if (param == nullptr || strlen(param) == 0) {
 		return false;
 	}
 
-	// Vrifier que chaque caractre de la chane est soit "H" soit "R"
+	// Vérifier que chaque caractère de la chaîne est soit "H" soit "R" soit "P" soit "M"
 	for (unsigned int i = 0; i < strlen(param); ++i) {
 		type = toupper(param[i]);
-		if (type != 'H' && type != 'R') {
+		if (type != 'H' && type != 'R' && type != 'P' && type != 'M') {
 			return true;
 		}
 	}
@@ -67,56 +72,52 @@ bool verifJoueur(const char* argv[]) {
 	return false;
 }
 /**
-* @brief Charge le dictionnaire de mots
-* @param[in,out] p: La partie  laquelle le dico est associ
+* @brief Demande le dictionnaire de mots au registre, qui le charge en arrière-plan une seule fois par processus
+* @param[in,out] p: La partie à laquelle le dico est associé
 * @pre p est valide
+* @see demanderDico, attendreDicoPartie
 */
 void initialiserDico(Partie& p) {
-	p.d.nbMot = 0;
-
-	//Ouverture du dico
-	ifstream dico("./ods4.txt");
-	if (!dico.good()) cout << "Dico pas ouvert";
-
-	//Se placer au dbut du fichier
-	dico.clear();
-	dico.seekg(0, ios::beg);
-
-	//Compte le nombre de mots dans le dico
-	char* mot = new char[MAX];
-	mot[0] = '\0';
-	p.d.nbMot = 0;
-	while (dico >> setw(MAX) >> mot) {
-		p.d.nbMot++;
+	p.dicoPropre = demanderDico("./ods4.txt", "./ods4.bin");
+	p.d = p.dicoPropre;
+	p.dicoPret = false;
+}
+/**
+* @brief Attend que le dictionnaire de la partie soit chargé, avant de le lire
+* @param[in,out] p: La partie
+* @note Les lettres annoncées pendant le chargement n'ont pas fait descendre le noeud du mot tapé : il est recalculé
+*/
+void attendreDicoPartie(Partie& p) {
+	if (p.dicoPret) return;
+	attendreDico(p.d);
+	p.dicoPret = true;
+	if (p.d->nbMot == 0) {
+		*p.sortie << "Dico pas ouvert" << finLigne;
 	}
-	delete[] mot;
-
-	//Se placer au dbut du fichier
-	dico.clear();
-	dico.seekg(0, ios::beg);
 
-	// Allouer un tableau de mots
-	char* motTemp;
-	motTemp = new char[MAX];
-	p.d.mots = new char* [p.d.nbMot];
-	for (unsigned int i = 0; i < p.d.nbMot ; ++i) {
-		dico >> setw(MAX) >> motTemp;
-		p.d.mots[i] = new char[strlen(motTemp)+1];
-		strcpy(p.d.mots[i],motTemp);
+	p.noeudMotTap = 0;
+	for (unsigned int i = 0; i < p.posLettre && p.noeudMotTap != AUCUN_NOEUD; ++i) {
+		if (p.motTap[i] != '?' && p.motTap[i] != '!') p.noeudMotTap = filsNoeud(*p.d, p.noeudMotTap, p.motTap[i]);
 	}
-	delete[] motTemp;
-
-	// Fermer le fichier
-	dico.close();
 }
 /**
 * @brief Initialise une partie
-* @param[in,out] p: La partie  initialiser
-* @param[in] argv : Les arguments de la commande utiliss pour initialiser la partie
-* @pre argv doit tre valide
+* @param[in,out] p: La partie à initialiser
+* @param[in] argv : Les arguments de la commande utilisés pour initialiser la partie
+* @param[in] graine: La graine des tirages des robots
+* @pre argv doit être valide
 * @see initialiserDico
 */
-void initialiserPartie(Partie& p, const char* argv[]) {
+void initialiserPartie(Partie& p, const char* argv[], unsigned long long graine) {
+
+	p.sortie = &sortieConsole();
+	p.etat = TOUR_A_JOUER;
+	p.graine = graine;
+	initialiserGenerateur(p.hasard, graine);
+	p.seuilCoup = 0;
+	p.reflexionCoup = 0;
+	p.livre = nullptr;
+	p.pool = nullptr;
 
 	const char* param = argv[1];
 	p.nbJoueurs = (unsigned int)strlen(param);
@@ -130,111 +131,162 @@ void initialiserPartie(Partie& p, const char* argv[]) {
 	}
 
 	p.tourActuel = 0;
-	p.tailleMot = 2;
-	
-	
-	p.motTap = new char[p.tailleMot + 1];
 	p.motTap[0] = '\0';
 	p.posLettre = 0;
-	p.motTapVerif = new char[MAX];
 	p.motTapVerif[0] = '\0';
 
-	//Allocation du dico en mmoire
+	//Allocation du dico en mémoire
 	initialiserDico(p);
+	p.noeudMotTap = 0;
+
+	// Les robots parfaits jouent d'après le jeu résolu pour ce nombre de joueurs
+	p.solutionPropre = new Solution;
+	p.solutionPropre->nbNoeuds = 0;
+	p.solutionPropre->coups = nullptr;
+	p.solutionPropre->perdants = nullptr;
+	for (unsigned int i = 0; i < p.nbJoueurs; ++i) {
+		if (p.joueurs[i].type == 'P') {
+			attendreDicoPartie(p);
+			resoudre(*p.solutionPropre, *p.d, p.nbJoueurs, 0);
+			break;
+		}
+	}
+	p.solution = p.solutionPropre;
+}
+/**
+* @brief Initialise une partie avec les mêmes joueurs et la même graine qu'une autre, en partageant son dictionnaire et son jeu résolu
+* @param[out] p: La partie à initialiser
+* @param[in] modele: La partie initialisée dont le dictionnaire est partagé
+* @pre modele doit rester valide tant que p l'est
+* @see initialiserPartie
+*/
+void initialiserPartieCopie(Partie& p, const Partie& modele) {
+	p.sortie = modele.sortie;
+	p.etat = TOUR_A_JOUER;
+	p.graine = modele.graine;
+	initialiserGenerateur(p.hasard, p.graine);
+	p.seuilCoup = modele.seuilCoup;
+	p.reflexionCoup = modele.reflexionCoup;
+	p.livre = modele.livre;
+	p.pool = nullptr; // Les parties d'un tournoi occupent déjà chacune un fil d'exécution
+	p.nbJoueurs = modele.nbJoueurs;
+	p.joueurs = new Joueur[p.nbJoueurs];
+	for (unsigned int i = 0; i < p.nbJoueurs; ++i) {
+		p.joueurs[i].type = modele.joueurs[i].type;
+		p.joueurs[i].score = 0;
+	}
+
+	p.tourActuel = 0;
+	p.motTap[0] = '\0';
+	p.posLettre = 0;
+	p.motTapVerif[0] = '\0';
+	p.noeudMotTap = 0;
+
+	// Seul ce qui change pendant une partie lui est propre
+	p.d = modele.d;
+	p.dicoPropre = nullptr;
+	p.dicoPret = modele.dicoPret;
+	p.solution = modele.solution;
+	p.solutionPropre = nullptr;
 }
 /**
-* @brief Vrifie si le mot tap par le joueur est vide
+* @brief Remet une partie à son début, en gardant les joueurs et le dictionnaire
+* @param[in,out] p: La partie à recommencer
+*/
+void recommencerPartie(Partie& p) {
+	for (unsigned int i = 0; i < p.nbJoueurs; ++i) {
+		p.joueurs[i].score = 0;
+	}
+	p.tourActuel = 0;
+	p.posLettre = 0;
+	p.motTap[0] = '\0';
+	p.motTapVerif[0] = '\0';
+	p.noeudMotTap = 0;
+	p.etat = TOUR_A_JOUER;
+}
+/**
+* @brief Vérifie si le mot tapé par le joueur est vide
 * @param[in] p: La partie en cours
-* @return Vrai si le mot tap est vide, faux sinon
+* @return Vrai si le mot tapé est vide, faux sinon
 */
 bool estZeroLettre(Partie& p) {
 	return (p.motTap[0] == '\0');
 }
 /**
-* @brief Vrifie si le mot tap par le joueur n'a qu'une seule lettre
+* @brief Vérifie si le mot tapé par le joueur n'a qu'une seule lettre
 * @param[in] p: La partie en cours
-* @return Vrai si le mot tap n'a qu'une seule lettre, faux sinon
+* @return Vrai si le mot tapé n'a qu'une seule lettre, faux sinon
 */
 bool estPremiereLettre(Partie& p) {
 	return (p.motTap[0] == '\0' || p.motTap[1] == '\0');
 }
 /**
-* @brief Vrifie si le mot tap par le joueur n'a que deux lettres ou qu'une lettre suivie d'un '?'
+* @brief Vérifie si le mot tapé par le joueur n'a que deux lettres ou qu'une lettre suivie d'un '?'
 * @param[in] p: La partie en cours
-* @return Vrai si le mot tap n'a que deux lettres ou qu'une lettre suivie d'un '?', faux sinon
+* @return Vrai si le mot tapé n'a que deux lettres ou qu'une lettre suivie d'un '?', faux sinon
 */
 bool estDeuxLettre(Partie& p) {
 	return (p.motTap[0] == '\0' || p.motTap[1] == '\0' || p.motTap[2] == '\0' || p.motTap[2] == '?');
 }
 /**
-* @brief Vrifie si un mot est valide (si il est prsent dans le dictionnaire de la partie)
+* @brief Vérifie si un mot est valide (si il est présent dans le dictionnaire de la partie)
 * @param[in] p: La partie en cours
-* @param[in] mot: Le mot  vrifier
+* @param[in] mot: Le mot à vérifier
 * @return Vrai si le mot est valide, faux sinon
 */
-bool estMotValide(Partie& p, char* mot) {
-	
+bool estMotValide(Partie& p, const char* mot) {
+	attendreDicoPartie(p);
+	COMPTER(nbVerifications, 1);
+	if (p.d->filtre != nullptr) return chercherTable(*p.d, mot);
+
 	int min = 0;
-	int max = p.d.nbMot - 1;
+	int max = p.d->nbMot - 1;
 	int milieu;
 	while (min <= max){
 		milieu = (min + max) / 2;
-		if (strcmp(p.d.mots[milieu], mot) == 0) return true;
-		else if (strcmp(p.d.mots[milieu], mot) < 0) min = milieu + 1;
+		COMPTER(nbSondes, 1);
+		if (comparerMot(motDico(*p.d, milieu), mot) == 0) return true;
+		else if (comparerMot(motDico(*p.d, milieu), mot) < 0) min = milieu + 1;
 		else max = milieu - 1;
 	}
 	return false;
 	
 }
 /**
-* @brief Agrandi la taille de la chane de caractre du mot tap
+* @brief Ajoute une lettre au mot tapé par le joueur
 * @param[in,out] p: La partie en cours
-*/
-void agrandir(Partie& p) {
-
-	unsigned int newMax = p.tailleMot + 1;
-	
-	char* newMot = new char[newMax+1];
-	strcpy(newMot, p.motTap);
-	
-	delete[] p.motTap;
-	p.motTap = new char[newMax + 1];
-	strcpy(p.motTap, newMot);
-	
-	p.tailleMot = newMax;
-	
-	delete[] newMot;
-	
-}
-
-/**
-* @brief Ajoute une lettre au mot tap par le joueur
-* @param[in,out] p: La partie en cours
-* @param[in] c: La lettre  ajouter
+* @param[in] c: La lettre à ajouter
+* @note Aucun mot n'a plus de MAX - 1 lettres : au-delà, seuls '?' et '!' sont encore ajoutés
 */
 void ajoutLettre(Partie& p, char c) {
 	
-	if (p.posLettre >= p.tailleMot) {
-		agrandir(p);
+	if (p.posLettre >= TAILLE_MOT_TAPE - 1 || (p.posLettre >= MAX - 1 && c != '?' && c != '!')) {
+		return;
 	}
 	
 	p.motTap[p.posLettre] = toupper(c); // Majuscule
 	p.motTap[p.posLettre + 1] = '\0';
 	++p.posLettre;
+
+	// Le noeud du mot tapé descend d'un fils : '?' et '!' ne font pas partie du mot
+	if (p.dicoPret && p.noeudMotTap != AUCUN_NOEUD && p.motTap[p.posLettre - 1] != '?' && p.motTap[p.posLettre - 1] != '!') {
+		p.noeudMotTap = filsNoeud(*p.d, p.noeudMotTap, p.motTap[p.posLettre - 1]);
+	}
 }
 /**
-* @brief Demande  l'utilisateur de saisir une lettre et l'ajoute au mot tap par le joueur
+* @brief Demande à l'utilisateur de saisir une lettre et l'ajoute au mot tapé par le joueur
 * @param[in,out] p: La partie en cours
 */
 void saisiHumain(Partie& p) {
+	viderSortie(*p.sortie); // L'invite doit être affichée avant la saisie
 	char c;
 	cin >> c;
 	ajoutLettre(p, c);
 	cin.ignore(INT_MAX, '\n');
 }
 /**
-* @brief Vrifie si un caractre est une voyelle
-* @param[in] c: Le caractre  vrifier
+* @brief Vérifie si un caractère est une voyelle
+* @param[in] c: Le caractère à vérifier
 * @return Vrai si c est une voyelle, faux sinon
 */
 bool estVoyelle(const char c) {
@@ -245,8 +297,8 @@ bool estVoyelle(const char c) {
 	return false;
 }
 /**
-* @brief Vrifie si un caractre est une consonne
-* @param[in] c: Le caractre  vrifier
+* @brief Vérifie si un caractère est une consonne
+* @param[in] c: Le caractère à vérifier
 * @return Vrai si c est une consonne, faux sinon
 * @see estVoyelle
 */
@@ -254,9 +306,9 @@ bool estConsonne(const char c) {
 	return !estVoyelle(c);
 }
 /**
-* @brief Vrifie si le dernier caractre tap par le joueur est un point d'interrogation
+* @brief Vérifie si le dernier caractère tapé par le joueur est un point d'interrogation
 * @param[in,out] p: La partie en cours
-* @return Vrai si le dernier caractre est un point d'interrogation, faux sinon
+* @return Vrai si le dernier caractère est un point d'interrogation, faux sinon
 */
 bool ptInterrogation(Partie& p) {
 	if (estZeroLettre(p)) {
@@ -269,7 +321,7 @@ bool ptInterrogation(Partie& p) {
 	}
 }
 /**
-* @brief Le robot tape un mot dans le cas o le joueur a tap un point d'interrogation
+* @brief Le robot tape un mot dans le cas où le joueur a tapé un point d'interrogation
 * @param[in,out] p: La partie en cours
 */
 void casPtInterroR(Partie& p) {
@@ -280,53 +332,27 @@ void casPtInterroR(Partie& p) {
 			p.motTapVerif[i] = toupper(motRobot[i]);
 		}
 		p.motTapVerif[strlen(motRobot)] = '\0';
-		cout << p.motTapVerif << endl;
+		*p.sortie << p.motTapVerif << finLigne;
 	}
 	else {
 		
-		// On regarde les premires lettres du mot tap
-		char* prefixe = new char[MAX];
-		for (unsigned int i = 0; i < p.posLettre - 1; i++) {
-			prefixe[i] = p.motTap[i];
-		}
-		prefixe[p.posLettre - 1] = '\0';
-		unsigned int lenghPref = strlen(prefixe);
-
-		// On compte le nombre de mots qui commencent par ce prfixe
-		unsigned int nbMots = 0;
-		for (unsigned int i = 0; i < p.d.nbMot; i++) {
-			if (strncmp(p.d.mots[i], prefixe, lenghPref) == 0) {
-				nbMots++;
-			}
-		}
+		// Le noeud du mot tapé, sans le '?', donne les mots qui commencent par ces lettres, contigus dans le dico
+		unsigned int noeud = p.noeudMotTap;
 
-		if (nbMots > 0) {
-			unsigned int motChoisi = rand() % nbMots;
-			unsigned int motCompte = 0;
+		if (noeud != AUCUN_NOEUD) {
+			const Noeud& n = p.d->noeuds[noeud];
+			const char* mot = motDico(*p.d, n.debut + tirerBorne(p.hasard, n.nbMots)); // Le mot choisi
 
-			do {
-				for (unsigned int i = 0; i < p.d.nbMot; i++) {
-					if (strncmp(p.d.mots[i], prefixe, lenghPref) == 0) { // Trouve d'abord la partie du dico o commence ce prefixe
-						if (motCompte == motChoisi) { // Vrifie si c'est le mot choisi
-							prefixe = p.d.mots[i];
-							break;
-						}
-						motCompte++;
-					}
-				}
-
-			} while (!estMotValide(p, prefixe));
-
-			unsigned int longueur = strlen(prefixe);
+			unsigned int longueur = longueurMot(mot);
 			for (unsigned int i = 0; i < longueur; ++i) {
-				p.motTapVerif[i] = prefixe[i];
+				p.motTapVerif[i] = mot[i];
 			}
-			p.motTapVerif[strlen(prefixe)] = '\0';
-			cout << p.motTapVerif << endl;
+			p.motTapVerif[longueur] = '\0';
+			*p.sortie << p.motTapVerif << finLigne;
 		}
 		else {
 			c = '!';
-			cout << c << endl;
+			*p.sortie << c << finLigne;
 			p.motTapVerif[0] = c;
 			p.motTapVerif[1] = '\0';
 		}
@@ -334,120 +360,153 @@ void casPtInterroR(Partie& p) {
 	}
 }
 /**
-* @brief Cas du robot o il tape une lettre
+* @brief Cas du robot où il tape une lettre
 * @param[in,out] p: La partie en cours
 */
 void casNormalSaisiR(Partie& p) {
 	char c = '\0';
 	if (estZeroLettre(p)) {
 		char lettres[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-		unsigned int index = rand() % 26;
+		unsigned int index = tirerBorne(p.hasard, 26);
+		COMPTER(nbTirages, 1);
 		c = lettres[index];
-		cout << c << endl;
+		*p.sortie << c << finLigne;
 		ajoutLettre(p, c);
 	}
 	else {
 
-		unsigned int nbTest = 0;
-
-		// On regarde les premires lettres du mot tap
-		char* prefixe = new char[MAX];
-		for (unsigned int i = 0; i < p.posLettre; i++) {
-			prefixe[i] = p.motTap[i];
+		// Les fils du noeud du mot tapé sont les lettres qui peuvent le suivre, chacune avec son nombre de mots
+		const Noeud* fils = nullptr;
+		unsigned int nbFils = 0;
+		unsigned int nbMots = 0;
+		if (p.noeudMotTap != AUCUN_NOEUD) {
+			const Noeud& n = p.d->noeuds[p.noeudMotTap];
+			fils = p.d->noeuds + n.premierFils;
+			nbFils = n.nbFils;
+			nbMots = n.nbMots;
 		}
-		prefixe[p.posLettre] = '\0';
-		unsigned int lenghPref = strlen(prefixe);
 
-		// On compte le nombre de mots qui commencent par ce prfixe
-		unsigned int nbMots = 0;
-		for (unsigned int i = 0; i < p.d.nbMot; i++) {
-			if (strncmp(p.d.mots[i], prefixe, lenghPref) == 0) {
-				nbMots++;
+		// Si il y a au moins un mot qui commence par ce préfixe, on choisit une lettre parmi celles qui peuvent le suivre,
+		// chacune avec une chance proportionnelle au nombre de mots qui continuent par elle
+		if (nbFils > 0) {
+			unsigned int nbSuite = 0;
+			for (unsigned int i = 0; i < nbFils; ++i) {
+				nbSuite += fils[i].nbMots;
 			}
-		}
 
-		// Si il y a au moins un mot qui commence par ce prfixe, on choisit une lettre alatoirement parmi les mots qui commencent par ce prfixe
-		if (nbMots > 0) {
-			unsigned int motChoisi = rand() % nbMots;
-			unsigned int motCompte = 0;
+			unsigned int tirage = tirerBorne(p.hasard, nbSuite);
+			COMPTER(nbTirages, 1);
+			unsigned int choisi = 0;
+			while (tirage >= fils[choisi].nbMots) {
+				tirage -= fils[choisi].nbMots;
+				++choisi;
+			}
+			c = fils[choisi].lettre;
 
-			do {
-				for (unsigned int i = 0; i < p.d.nbMot; i++) {
-					if (strncmp(p.d.mots[i], prefixe, lenghPref) == 0) { // Trouve d'abord la partie du dico o commence ce prefixe
-						if (motCompte == motChoisi) { // Vrifie si c'est le mot choisi
-							c = p.d.mots[i][p.posLettre]; // Rcupre la lettre suivante du mot choisi
+			if (nbMots <= 3 && fils[choisi].estMot) {
+				c = '?';
+			}
+			else if (!estPremiereLettre(p) && fils[choisi].estMot) {
+				// La lettre finirait un mot : on tire parmi les lettres qui ne forment pas un mot
+				unsigned int nbSurs = 0;
+				for (unsigned int i = 0; i < nbFils; ++i) {
+					if (!fils[i].estMot) nbSurs += fils[i].nbMots;
+				}
+				if (nbSurs > 0) {
+					tirage = tirerBorne(p.hasard, nbSurs);
+					COMPTER(nbTirages, 1);
+					for (unsigned int i = 0; i < nbFils; ++i) {
+						if (fils[i].estMot) continue;
+						if (tirage < fils[i].nbMots) {
+							c = fils[i].lettre;
 							break;
 						}
-						motCompte++;
+						tirage -= fils[i].nbMots;
 					}
 				}
-
-
-				prefixe[p.posLettre] = toupper(c); // Majuscule
-				prefixe[p.posLettre + 1] = '\0';
-				if (nbMots <= 3 && estMotValide(p, prefixe)) {
-					c = '?';
-					break;
-				}
-				else {
-					motChoisi = rand() % nbMots;
-					motCompte = 0;
-				}
-
-				if (estPremiereLettre(p)) break;
-			
-				++nbTest;
-
-				if (nbMots > 2000) {
-					if (nbTest > nbMots / 4) {
-						if (estConsonne(prefixe[p.posLettre - 1])) {
-							char voyelle[6] = { 'a', 'e', 'i', 'o', 'u', 'y' };
-							unsigned int index = rand() % 6;
-							c = voyelle[index];
-							break;
-						}
-						else {
-							char consonnes[21] = { 'b', 'c', 'd', 'f', 'g', 'h', 'j', 'k', 'l', 'm', 'n', 'p', 'q', 'r', 's', 't', 'v', 'w', 'x', 'y', 'z' };
-							unsigned int index = rand() % 21;
-							c = consonnes[index];
-							break;
-						}
-						break;
+				else if (nbMots > 2000) {
+					if (estConsonne(p.motTap[p.posLettre - 1])) {
+						char voyelle[6] = { 'a', 'e', 'i', 'o', 'u', 'y' };
+						unsigned int index = tirerBorne(p.hasard, 6);
+						COMPTER(nbTirages, 1);
+						c = voyelle[index];
+					}
+					else {
+						char consonnes[21] = { 'b', 'c', 'd', 'f', 'g', 'h', 'j', 'k', 'l', 'm', 'n', 'p', 'q', 'r', 's', 't', 'v', 'w', 'x', 'y', 'z' };
+						unsigned int index = tirerBorne(p.hasard, 21);
+						COMPTER(nbTirages, 1);
+						c = consonnes[index];
 					}
-					
 				}
 				else {
-					if (nbTest > nbMots / 2) {
-						c = '?';
-						break;
-					}
+					c = '?';
 				}
-				
-			} while (estMotValide(p, prefixe));
+			}
 
-			cout << c << endl;
+			*p.sortie << c << finLigne;
 			ajoutLettre(p, c);
 		}
 		else {
 			c = '?';
-			cout << c << endl;
+			*p.sortie << c << finLigne;
 			ajoutLettre(p, c);
 		}
-		delete[] prefixe;
 	}
 }
 /**
-* @brief Gnre une lettre alatoire pour le robot
+* @brief Cas du robot parfait où il tape la lettre donnée par le jeu résolu
 * @param[in,out] p: La partie en cours
 */
-void saisiRobot(Partie& p) {
-	char c = '\0';
+void casParfaitSaisiR(Partie& p) {
+	char c = '?';
+	unsigned int noeud = p.noeudMotTap;
 
+	// Si le préfixe ne commence aucun mot, le joueur précédent est contesté
+	if (noeud != AUCUN_NOEUD && coupSolution(*p.solution, noeud) != '\0') {
+		c = coupSolution(*p.solution, noeud);
+	}
+	*p.sortie << c << finLigne;
+	ajoutLettre(p, c);
+}
+/**
+* @brief Cas du robot Monte-Carlo où il tape la lettre qui l'a fait perdre le moins souvent dans des fins de manche jouées au hasard
+* @param[in,out] p: La partie en cours
+* @note Le coup dure le temps de réflexion de la partie, REFLEXION_MONTE_CARLO si elle n'en donne pas,
+* sauf pour les deux premières lettres d'une manche, lues dans le livre d'ouvertures s'il y en a un
+*/
+void casMonteCarloSaisiR(Partie& p) {
+	char c = (p.livre != nullptr) ? coupLivre(*p.livre, *p.d, p.nbJoueurs, p.motTap) : '\0';
+	if (c != '\0') {
+		COMPTER(nbCoupsLivre, 1);
+	}
+	else {
+		unsigned long long reflexion = (p.reflexionCoup > 0) ? p.reflexionCoup : (unsigned long long)REFLEXION_MONTE_CARLO;
+		c = coupMonteCarlo(p.pool, *p.d, p.noeudMotTap, p.posLettre, p.nbJoueurs, reflexion, tirer(p.hasard));
+	}
+	*p.sortie << c << finLigne;
+	ajoutLettre(p, c);
+}
+/**
+* @brief Génère une lettre aléatoire pour le robot
+* @param[in,out] p: La partie en cours
+*/
+void saisiRobot(Partie& p) {
+	attendreDicoPartie(p);
+	DEBUT_MESURE(debut);
 	if (ptInterrogation(p)) {
 		casPtInterroR(p);
+		FIN_MESURE(debut, coupsInterrogation, nsCoupsInterrogation, p.seuilCoup);
+	}
+	else if (p.joueurs[p.tourActuel].type == 'P' && p.solution->nbNoeuds > 0) {
+		casParfaitSaisiR(p);
+	}
+	else if (p.joueurs[p.tourActuel].type == 'M') {
+		casMonteCarloSaisiR(p);
+		FIN_MESURE(debut, coupsMonteCarlo, nsCoupsMonteCarlo, p.seuilCoup);
 	}
 	else {
 		casNormalSaisiR(p);
+		FIN_MESURE(debut, coupsNormaux, nsCoupsNormaux, p.seuilCoup);
 	}
 
 }
@@ -466,50 +525,42 @@ void jouer(Partie& p) {
 
 }
 /**
-* @brief Affiche le mot tap par le joueur courant dans la partie en cours
+* @brief Affiche le mot tapé par le joueur courant dans la partie en cours
 * @param[in] p: La partie en cours
 */
 void motSaisi(Partie& p) {
-	unsigned int longueur = strlen(p.motTap);
-	for (unsigned int i = 0; i < longueur; ++i) {
-		if (p.motTap[i] == 0) {
-			break;
-		}
-		else {
-			cout << p.motTap[i];
-		}
-	}
+	*p.sortie << p.motTap;
 }
 /**
-* @brief Affiche l'tat de la partie en cours
+* @brief Affiche l'état de la partie en cours
 * @param[in,out] p: La partie en cours
 */
 void afficher(Partie& p) {
-	cout << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << ", " << "(";
+	*p.sortie << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << ", " << "(";
 	motSaisi(p);
-	cout << ")" << " > ";
+	*p.sortie << ")" << " > ";
 }
 /**
-* @brief Fonction permettant de mettre  jour le score d'un joueur
+* @brief Fonction permettant de mettre à jour le score d'un joueur
 * @param[in] p: La partie en cours
-* @param[in] i: L'indice du joueur dont on veut mettre  jour le score
+* @param[in] i: L'indice du joueur dont on veut mettre à jour le score
 */
 void score(Partie& p, unsigned int i) {
 	switch (p.joueurs[i].score) {
 	case 1:
-		cout << "0.25";
+		*p.sortie << "0.25";
 		break;
 	case 2:
-		cout << "0.5";
+		*p.sortie << "0.5";
 		break;
 	case 3:
-		cout << "0.75";
+		*p.sortie << "0.75";
 		break;
 	case 4:
-		cout << "1";
+		*p.sortie << "1";
 		break;
 	default:
-		cout << "0";
+		*p.sortie << "0";
 		break;
 	}
 }
@@ -520,14 +571,14 @@ void score(Partie& p, unsigned int i) {
 void afficheScore(Partie& p) {
 	for (unsigned int i = 0; i < p.nbJoueurs; ++i) {
 		if (i == p.nbJoueurs - 1) {
-			cout << i + 1 << p.joueurs[i].type << " : ";
+			*p.sortie << i + 1 << p.joueurs[i].type << " : ";
 			score(p, i);
-			cout << endl;
+			*p.sortie << finLigne;
 		}
 		else {
-			cout << i + 1 << p.joueurs[i].type << " : ";
+			*p.sortie << i + 1 << p.joueurs[i].type << " : ";
 			score(p, i);
-			cout << "; ";
+			*p.sortie << "; ";
 		}
 	}
 }
@@ -539,7 +590,7 @@ void ajouteScore(Partie& p) {
 	++p.joueurs[p.tourActuel].score;
 }
 /**
-* @brief Rinitialiser la manche en cours
+* @brief Réinitialiser la manche en cours
 * @param[in,out] p : La partie en cours
 */
 void resetManche(Partie& p) {
@@ -550,53 +601,54 @@ void resetManche(Partie& p) {
 	}
 	--p.tourActuel;
 	p.posLettre = 0;
+	p.noeudMotTap = 0;
 	return;
 }
 /**
-* @brief Message si le mot tap par le joueur existe dans le dictionnaire
+* @brief Message si le mot tapé par le joueur existe dans le dictionnaire
 * @param[in,out] p : La partie en cours
 */
 void motExiste(Partie& p) {
-	cout << "le mot "; motSaisi(p); cout << " existe, le joueur ";
-	cout << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << endl;
+	*p.sortie << "le mot "; motSaisi(p); *p.sortie << " existe, le joueur ";
+	*p.sortie << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << finLigne;
 	ajouteScore(p);
 	afficheScore(p);
 	resetManche(p);
 
 }
 /**
-* @brief Message si le mot tap par le joueur n'est pas le mme que le mot tap
+* @brief Message si le mot tapé par le joueur n'est pas le même que le mot tapé
 * @param[in,out] p : La partie en cours
 */
 void lettresDifferentes(Partie& p) {
-	cout << "le mot " << p.motTapVerif << " ne commence pas par les lettres attendues, le joueur " << p.tourActuel << p.joueurs[p.tourActuel - 1].type << " prend un quart de singe" << endl;
+	*p.sortie << "le mot " << p.motTapVerif << " ne commence pas par les lettres attendues, le joueur " << p.tourActuel << p.joueurs[p.tourActuel - 1].type << " prend un quart de singe" << finLigne;
 	--p.tourActuel; // Recule d'un tour donc d'un joueur
 	ajouteScore(p);
 	afficheScore(p);
 	resetManche(p);
 }
 /**
-* @brief Message si le mot tap par le joueur existe
+* @brief Message si le mot tapé par le joueur existe
 * @param[in,out] p : La partie en cours
 */
 void motExisteVerif(Partie& p) {
-	cout << "le mot " << p.motTapVerif << " existe, le joueur ";
+	*p.sortie << "le mot " << p.motTapVerif << " existe, le joueur ";
 	if (p.tourActuel == p.nbJoueurs) {
 		p.tourActuel = 0;
-		cout << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << endl; // Cas particulier du dernier/premier joueur
+		*p.sortie << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << finLigne; // Cas particulier du dernier/premier joueur
 	}
 	else
-		cout << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << endl;
+		*p.sortie << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << finLigne;
 	ajouteScore(p);
 	afficheScore(p);
 	resetManche(p);
 }
 /**
-* @brief Message si le mot tap par le joueur n'existe pas
+* @brief Message si le mot tapé par le joueur n'existe pas
 * @param[in,out] p : La partie en cours
 */
 void motExistePas(Partie& p) {
-	cout << "le mot " << p.motTapVerif << " n'existe pas, " << p.tourActuel << p.joueurs[p.tourActuel - 1].type << " prend un quart de singe" << endl;
+	*p.sortie << "le mot " << p.motTapVerif << " n'existe pas, " << p.tourActuel << p.joueurs[p.tourActuel - 1].type << " prend un quart de singe" << finLigne;
 	if (p.tourActuel == 0) {
 		p.tourActuel = p.nbJoueurs;
 	}
@@ -612,6 +664,7 @@ void motExistePas(Partie& p) {
 void saisirMotTapVerif(Partie& p) {
 
 	if (p.joueurs[p.tourActuel - 1].type == 'H') {
+		viderSortie(*p.sortie); // L'invite doit être affichée avant la saisie
 		cin >> setw(MAX) >> p.motTapVerif;
 		cin.ignore(INT_MAX, '\n');
 		unsigned int longueur = strlen(p.motTapVerif);
@@ -629,15 +682,15 @@ void saisirMotTapVerif(Partie& p) {
 * @param[in,out] p : La partie en cours
 */
 void exclamation(Partie& p) {
-	cout << "le joueur " << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " abandonne la manche et prend un quart de singe" << endl;
+	*p.sortie << "le joueur " << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " abandonne la manche et prend un quart de singe" << finLigne;
 	ajouteScore(p);
 	afficheScore(p);
 	resetManche(p);
 }
 /**
-* @brief Verifie si le caractre tap est un point d'exclamation
+* @brief Verifie si le caractère tapé est un point d'exclamation
 * @param[in] p : La partie en cours
-* @return Vrai si le dernier caractre est un point d'exclamation, faux sinon
+* @return Vrai si le dernier caractère est un point d'exclamation, faux sinon
 */
 bool ptExclamation(Partie& p) {
 	if (p.posLettre == 0) return false;
@@ -645,9 +698,9 @@ bool ptExclamation(Partie& p) {
 	else return false;
 }
 /**
-* @brief Verifie si les caractres taps sont les mmes que le mot tap
+* @brief Verifie si les caractères tapés sont les mêmes que le mot tapé
 * @param[in] p : La partie en cours
-* @return retourne un boolen
+* @return retourne un booléen
 */
 bool verifLettres(Partie& p) {
 	unsigned int longueur = strlen(p.motTap);
@@ -658,16 +711,20 @@ bool verifLettres(Partie& p) {
 	return true;
 }
 /**
-* @brief Cas o c'est un point d'interrogation, on fait les vrifications
+* @brief Demande au joueur précédent le mot qu'il avait en tête, après un point d'interrogation
 * @param[in,out] p : La partie en cours
 */
-void verifInterrogation(Partie& p) {
+void inviterMot(Partie& p) {
 	if (p.tourActuel == 0) { // Cas particulier du dernier/premier joueur
 		p.tourActuel = p.nbJoueurs;
 	}
-	cout << p.tourActuel << p.joueurs[p.tourActuel - 1].type << ", saisir le mot > ";
-	saisirMotTapVerif(p);
-
+	*p.sortie << p.tourActuel << p.joueurs[p.tourActuel - 1].type << ", saisir le mot > ";
+}
+/**
+* @brief Décide qui prend un quart de singe d'après le mot saisi par le joueur précédent
+* @param[in,out] p : La partie en cours
+*/
+void conclureInterrogation(Partie& p) {
 	if (!verifLettres(p)) {
 		lettresDifferentes(p);
 	}
@@ -692,7 +749,16 @@ void verifInterrogation(Partie& p) {
 	}
 }
 /**
-* @brief Cas o c'est un point d'exclamation, on fait les vrifications
+* @brief Cas où c'est un point d'interrogation, on fait les vérifications
+* @param[in,out] p : La partie en cours
+*/
+void verifInterrogation(Partie& p) {
+	inviterMot(p);
+	saisirMotTapVerif(p);
+	conclureInterrogation(p);
+}
+/**
+* @brief Cas où c'est un point d'exclamation, on fait les vérifications
 * @param[in,out] p : La partie en cours
 */
 void verifExclamation(Partie& p) {
@@ -703,7 +769,9 @@ void verifExclamation(Partie& p) {
 * @param[in,out] p : La partie en cours
 */
 void verifNormal(Partie& p) {
-	if (!estMotValide(p, p.motTap)) { // Vrification de la validit du mot
+	// Le noeud du mot tapé dit s'il est un mot, sans le chercher dans le dictionnaire
+	attendreDicoPartie(p);
+	if (p.noeudMotTap == AUCUN_NOEUD || !p.d->noeuds[p.noeudMotTap].estMot) {
 		return;
 	}
 	else { // Si le mot existe dans le dictionnaire
@@ -716,10 +784,10 @@ void verifNormal(Partie& p) {
 * @param[in,out] p : La partie en cours
 */
 void verification(Partie& p) {
-	if (ptInterrogation(p)) { // Si le joueur a tap ?
+	if (ptInterrogation(p)) { // Si le joueur a tapé ?
 		if (estPremiereLettre(p)) {
-			cout << "Aucun mot n'a t saisi, ";
-			cout << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << endl;
+			*p.sortie << "Aucun mot n'a été saisi, ";
+			*p.sortie << p.tourActuel + 1 << p.joueurs[p.tourActuel].type << " prend un quart de singe" << finLigne;
 			ajouteScore(p);
 			afficheScore(p);
 			resetManche(p);
@@ -729,51 +797,141 @@ void verification(Partie& p) {
 		}
 		
 	}
-	else if (ptExclamation(p)) { // Si le joueur a tap !
+	else if (ptExclamation(p)) { // Si le joueur a tapé !
 		verifExclamation(p); // Verification des cas possibles
 	}
 	else {
 		if (!estDeuxLettre(p)) {
 			verifNormal(p); //Sinon verifications normales
 		}
-		else; //Si c'est la premire lettre, on ne fait rien
+		else; //Si c'est la première lettre, on ne fait rien
 	}
 }
 /**
+* @brief Passe au joueur suivant
+* @param[in,out] p : La partie en cours
+*/
+void passerTour(Partie& p) {
+	if (p.tourActuel == p.nbJoueurs - 1) p.tourActuel = 0;
+	else ++p.tourActuel;
+}
+/**
 * @brief Le jeu
 * @param[in, out] p : La partie en cours
 */
 void jouerPartie(Partie& p) {
+	DEBUT_ALLOCATIONS(debut);
 	while (p.joueurs[p.tourActuel].score != 4) {
 
 		afficher(p);
 		jouer(p);
 		verification(p);
 
-
-		if (p.tourActuel == p.nbJoueurs - 1) p.tourActuel = 0;
-		else ++p.tourActuel;
+		passerTour(p);
 	}
-	cout << "La partie est finie" << endl;
+	*p.sortie << "La partie est finie" << finLigne;
+	viderSortie(*p.sortie);
+	COMPTER(nbParties, 1);
+	FIN_ALLOCATIONS(debut);
 }
 /**
-* @brief Dtruit une partie et libre les ressources associes
-* @param[in,out] p: La partie  dtruire
+* @brief Vérifie le coup qui vient d'être joué, puis passe au joueur suivant
+* @param[in,out] p : La partie en cours
+* @note Si un humain doit d'abord saisir le mot qu'il avait en tête, la partie attend sa saisie
+*/
+static void verifierCoup(Partie& p) {
+	if (ptInterrogation(p) && !estPremiereLettre(p)) {
+		inviterMot(p);
+		if (p.joueurs[p.tourActuel - 1].type == 'H') {
+			p.etat = ATTENTE_MOT;
+			return;
+		}
+		saisiRobot(p);
+		conclureInterrogation(p);
+	}
+	else {
+		verification(p);
+	}
+	passerTour(p);
+}
+/**
+* @brief Fait avancer la partie jusqu'à ce qu'un humain doive saisir quelque chose ou qu'elle soit finie
+* @param[in,out] p : La partie en cours
+* @note Les robots jouent sans attendre. Le jeu est le même que celui de jouerPartie, qui attend les saisies sur cin.
+* @see fournirSaisie
+*/
+void avancerPartie(Partie& p) {
+	DEBUT_ALLOCATIONS(debut);
+	while (p.etat == TOUR_A_JOUER) {
+		if (p.joueurs[p.tourActuel].score == 4) {
+			*p.sortie << "La partie est finie" << finLigne;
+			p.etat = PARTIE_FINIE;
+			COMPTER(nbParties, 1);
+			break;
+		}
+		afficher(p);
+		if (p.joueurs[p.tourActuel].type == 'H') {
+			p.etat = ATTENTE_LETTRE;
+			break;
+		}
+		saisiRobot(p);
+		verifierCoup(p);
+	}
+	viderSortie(*p.sortie); // L'invite doit être affichée avant la saisie
+	FIN_ALLOCATIONS(debut);
+}
+/**
+* @brief Donne à la partie la ligne saisie par l'humain qu'elle attend, puis la fait avancer
+* @param[in,out] p : La partie en cours, qui attend une lettre ou un mot
+* @param[in] ligne: La ligne saisie, terminée par '\0'
+* @note Comme avec cin, les blancs sont ignorés : une ligne vide laisse la partie attendre.
+* Une lettre est le premier caractère de la ligne, un mot son premier mot.
+* @see avancerPartie
+*/
+void fournirSaisie(Partie& p, const char* ligne) {
+	while (*ligne == ' ' || *ligne == '\t' || *ligne == '\r' || *ligne == '\n') ++ligne;
+	if (*ligne == '\0') return;
+
+	DEBUT_ALLOCATIONS(debut);
+	if (p.etat == ATTENTE_LETTRE) {
+		p.etat = TOUR_A_JOUER;
+		ajoutLettre(p, *ligne);
+		verifierCoup(p);
+	}
+	else if (p.etat == ATTENTE_MOT) {
+		unsigned int longueur = 0;
+		while (longueur < MAX - 1 && ligne[longueur] != '\0' && ligne[longueur] != ' ' && ligne[longueur] != '\t'
+			&& ligne[longueur] != '\r' && ligne[longueur] != '\n') {
+			p.motTapVerif[longueur] = toupper(ligne[longueur]); // Majuscule
+			++longueur;
+		}
+		p.motTapVerif[longueur] = '\0';
+		p.etat = TOUR_A_JOUER;
+		conclureInterrogation(p);
+		passerTour(p);
+	}
+	FIN_ALLOCATIONS(debut); // Celles d'avancerPartie sont comptées par elle
+	avancerPartie(p);
+}
+/**
+* @brief Détruit une partie et libère les ressources associées
+* @param[in,out] p: La partie à détruire
+* @note Un dictionnaire ou un jeu résolu partagé n'est pas libéré, il appartient à la partie modèle
 */
 void detruirePartie(Partie& p) {
 	delete[] p.joueurs;
 	p.joueurs = nullptr;
-	delete[] p.motTap;
-	p.motTap = nullptr;
 
-	for (unsigned int i = 0; i < p.d.nbMot; ++i) {
-		delete[] p.d.mots[i];
+	if (p.dicoPropre != nullptr) {
+		rendreDico(p.dicoPropre); // Gardé par le registre pour les parties suivantes
+		p.dicoPropre = nullptr;
 	}
-	delete[] p.d.mots;
+	p.d = nullptr;
 
-	p.d.nbMot = NULL;
-	p.d.mots = nullptr;
-
-	delete[] p.motTapVerif;
-	p.motTapVerif = nullptr;
+	if (p.solutionPropre != nullptr) {
+		detruireSolution(*p.solutionPropre);
+		delete p.solutionPropre;
+		p.solutionPropre = nullptr;
+	}
+	p.solution = nullptr;
 }
\ No newline at end of file
@@ -5,145 +5,199 @@
 
 /**
  * @file fonctions.h
- * @brief Entte du composant de fonctions
+ * @brief Entête du composant de fonctions
  */
 
+#include "dico.h"
+#include "solveur.h"
+#include "hasard.h"
+#include "sortie.h"
+#include "livre.h"
+#include "montecarlo.h"
+
  /**
  * @brief Les constantes
  */
 enum {
 	MIN_JOUEURS = 2,
-	MAX = 28,
+	MAX_JOUEURS = 255, // Le solveur range un joueur par octet
+	TAILLE_MOT_TAPE = MAX + 1, // Les lettres du plus long mot possible, un '?' ou un '!', et le '\0'
 };
 
 /**
-* @brief Structure de donnes de type Dico
+* @brief Ce que la partie attend pour continuer
+* @see avancerPartie, fournirSaisie
 */
-struct Dico {
-	char** mots;
-	unsigned int nbMot;
+enum EtatPartie {
+	TOUR_A_JOUER, // Le joueur en cours peut jouer
+	ATTENTE_LETTRE, // Un humain doit saisir sa lettre
+	ATTENTE_MOT, // Un humain doit saisir le mot qu'il avait en tête
+	PARTIE_FINIE,
 };
 /**
-* @brief Structure de donnes de type Joueur
+* @brief Structure de données de type Joueur
 */
 struct Joueur {
-	char type; // H ou R
+	char type; // H, R, P (robot parfait) ou M (robot Monte-Carlo)
 	int score;
 };
 /**
-* @brief Structure de donnes de type Partie
+* @brief Structure de données de type Partie
 */
 struct Partie {
 	Joueur* joueurs;
 	unsigned int nbJoueurs;
-	char* motTap; // Lettres annonces pendant la partie
-	unsigned int tailleMot;
-	unsigned int posLettre; // Position o on doit insrer la lettre dans le mot
+	char motTap[TAILLE_MOT_TAPE]; // Lettres annoncées pendant la manche
+	unsigned int posLettre; // Position où on doit insérer la lettre dans le mot
+	unsigned int noeudMotTap; // Noeud de l'arbre des lettres de motTap, suivi par ajoutLettre, AUCUN_NOEUD si aucun mot ne les commence
 	unsigned int tourActuel; // Indice du joueur dans le tableau joueurs
-	char* motTapVerif;
-	Dico d;
+	char motTapVerif[MAX];
+	const Dico* d; // En lecture seule, peut être partagé par plusieurs parties
+	bool dicoPret; // Faux tant que d peut être en chargement : il faut l'attendre par attendreDicoPartie avant de le lire
+	const Solution* solution; // Jeu résolu, seulement s'il y a un robot parfait
+	Dico* dicoPropre; // Dictionnaire pris au registre par la partie, nullptr s'il est celui d'une partie modèle
+	Solution* solutionPropre; // Jeu résolu par la partie, nullptr s'il est partagé
+	Sortie* sortie; // Où la partie est affichée
+	EtatPartie etat; // Pour une partie jouée saisie par saisie, par avancerPartie et fournirSaisie
+	unsigned long long graine; // Graine des tirages des robots, la même graine rejoue les mêmes parties
+	Generateur hasard;
+	unsigned long long seuilCoup; // Durée d'un coup de robot en ns au-delà de laquelle --stats le compte, 0 sans seuil
+	unsigned long long reflexionCoup; // Temps de chaque coup du robot Monte-Carlo en ns, 0 pour REFLEXION_MONTE_CARLO
+	const Livre* livre; // Livre d'ouvertures du robot Monte-Carlo, nullptr sans livre, ouvert par le programme et partagé
+	PoolMonteCarlo* pool; // Fils qui cherchent les coups du robot Monte-Carlo, nullptr pour les chercher sur le fil de la partie
 };
 
 /**
 * @brief Verification du nombre de joueur
-* @param[in] argv : L'argument utilis pour compter le nombre de joueur
-* @return retourne un boolan
+* @param[in] argv : L'argument utilisé pour compter le nombre de joueur
+* @return retourne un booléan
 * @pre argv valide
 */
 bool verifNbJoueur(const char* argv[]);
 /**
-* @brief Vrifie le type de joueur
-* @param[in] argv : L'argument utilis pour vrifier le type de joueur
-* @return Retourne un boolen
-* @pre argv doit tre valide
+* @brief Vérifie le type de joueur
+* @param[in] argv : L'argument utilisé pour vérifier le type de joueur
+* @return Retourne un booléen
+* @pre argv doit être valide
 */
 bool verifJoueur(const char* argv[]);
 /**
-* @brief Charge le dictionnaire de mots
-* @param[in,out] p: La partie  laquelle le dictionnaire est associ
+* @brief Demande le dictionnaire de mots au registre, qui le charge en arrière-plan une seule fois par processus
+* @param[in,out] p: La partie qui possède le dictionnaire
 * @pre p est valide
+* @see demanderDico, attendreDicoPartie
 */
 void initialiserDico(Partie& p);
 /**
+* @brief Attend que le dictionnaire de la partie soit chargé, avant de le lire
+* @param[in,out] p: La partie
+* @note Les lettres annoncées pendant le chargement n'ont pas fait descendre le noeud du mot tapé : il est recalculé
+*/
+void attendreDicoPartie(Partie& p);
+/**
 * @brief Initialise une partie
-* @param[in,out] p: La partie  initialiser
-* @param[in] argv : Les arguments de la commande utiliss pour initialiser la partie
-* @pre argv doit tre valide
+* @param[in,out] p: La partie à initialiser
+* @param[in] argv : Les arguments de la commande utilisés pour initialiser la partie
+* @param[in] graine: La graine des tirages des robots
+* @pre argv doit être valide
 * @see initialiserDico
 */
-void initialiserPartie(Partie& p, const char* argv[]);
+void initialiserPartie(Partie& p, const char* argv[], unsigned long long graine);
+/**
+* @brief Initialise une partie avec les mêmes joueurs et la même graine qu'une autre, en partageant son dictionnaire et son jeu résolu
+* @param[out] p: La partie à initialiser
+* @param[in] modele: La partie initialisée dont le dictionnaire est partagé
+* @pre modele doit rester valide tant que p l'est
+* @see initialiserPartie
+*/
+void initialiserPartieCopie(Partie& p, const Partie& modele);
+/**
+* @brief Remet une partie à son début, en gardant les joueurs et le dictionnaire
+* @param[in,out] p: La partie à recommencer
+*/
+void recommencerPartie(Partie& p);
 /**
-* @brief Vrifie si le mot tap par le joueur est vide
+* @brief Vérifie si le mot tapé par le joueur est vide
 * @param[in] p: La partie en cours
-* @return Vrai si le mot tap est vide, faux sinon
+* @return Vrai si le mot tapé est vide, faux sinon
 */
 bool estZeroLettre(Partie& p);
 /**
-* @brief Vrifie si le mot tap par le joueur n'a qu'une seule lettre
+* @brief Vérifie si le mot tapé par le joueur n'a qu'une seule lettre
 * @param[in] p: La partie en cours
-* @return Vrai si le mot tap n'a qu'une seule lettre, faux sinon
+* @return Vrai si le mot tapé n'a qu'une seule lettre, faux sinon
 */
 bool estPremiereLettre(Partie& p);
 /**
-* @brief Vrifie si le mot tap par le joueur n'a que deux lettres ou qu'une lettre suivie d'un '?'
+* @brief Vérifie si le mot tapé par le joueur n'a que deux lettres ou qu'une lettre suivie d'un '?'
 * @param[in] p: La partie en cours
-* @return Vrai si le mot tap n'a que deux lettres ou qu'une lettre suivie d'un '?', faux sinon
+* @return Vrai si le mot tapé n'a que deux lettres ou qu'une lettre suivie d'un '?', faux sinon
 */
 bool estDeuxLettre(Partie& p);
 /**
-* @brief Vrifie si un mot est valide (si il est prsent dans le dictionnaire de la partie)
+* @brief Vérifie si un mot est valide (si il est présent dans le dictionnaire de la partie)
 * @param[in] p: La partie en cours
-* @param[in] mot: Le mot  vrifier
+* @param[in] mot: Le mot à vérifier
 * @return Vrai si le mot est valide, faux sinon
 */
-bool estMotValide(Partie& p, char* mot);
+bool estMotValide(Partie& p, const char* mot);
 /**
-* @brief Agrandi la taille de la chane de caractre du mot tap
+* @brief Ajoute une lettre au mot tapé par le joueur
 * @param[in,out] p: La partie en cours
-*/
-void agrandir(Partie& p);
-/**
-* @brief Ajoute une lettre au mot tap par le joueur
-* @param[in,out] p: La partie en cours
-* @param[in] c: La lettre  ajouter
+* @param[in] c: La lettre à ajouter
+* @note Aucun mot n'a plus de MAX - 1 lettres : au-delà, seuls '?' et '!' sont encore ajoutés
 */
 void ajoutLettre(Partie& p, char c);
 /**
-* @brief Demande  l'utilisateur de saisir une lettre et l'ajoute au mot tap par le joueur
+* @brief Demande à l'utilisateur de saisir une lettre et l'ajoute au mot tapé par le joueur
 * @param[in,out] p: La partie en cours
 */
 void saisiHumain(Partie& p);
 /**
-* @brief Vrifie si un caractre est une voyelle
-* @param[in] c: Le caractre  vrifier
+* @brief Vérifie si un caractère est une voyelle
+* @param[in] c: Le caractère à vérifier
 * @return Vrai si c est une voyelle, faux sinon
 */
 bool estVoyelle(const char c);
 /**
-* @brief Vrifie si un caractre est une consonne
-* @param[in] c: Le caractre  vrifier
+* @brief Vérifie si un caractère est une consonne
+* @param[in] c: Le caractère à vérifier
 * @return Vrai si c est une consonne, faux sinon
 * @see estVoyelle
 */
 bool estConsonne(const char c);
 /**
-* @brief Vrifie si le dernier caractre tap par le joueur est un point d'interrogation
+* @brief Vérifie si le dernier caractère tapé par le joueur est un point d'interrogation
 * @param[in,out] p: La partie en cours
-* @return Vrai si le dernier caractre est un point d'interrogation, faux sinon
+* @return Vrai si le dernier caractère est un point d'interrogation, faux sinon
 */
 bool ptInterrogation(Partie& p);
 /**
-* @brief Le robot tape un mot dans le cas o l'humain a tap un point d'interrogation
+* @brief Le robot tape un mot dans le cas où l'humain a tapé un point d'interrogation
 * @param[in,out] p: La partie en cours
 */
 void casPtInterroR(Partie& p);
 /**
-* @brief Cas du robot o il tape une lettre
+* @brief Cas du robot où il tape une lettre
 * @param[in,out] p: La partie en cours
 */
 void casNormalSaisiR(Partie& p);
 /**
-* @brief Gnre une lettre alatoire pour le robot
+* @brief Cas du robot parfait où il tape la lettre donnée par le jeu résolu
+* @param[in,out] p: La partie en cours
+* @see resoudre
+*/
+void casParfaitSaisiR(Partie& p);
+/**
+* @brief Cas du robot Monte-Carlo où il tape la lettre qui l'a fait perdre le moins souvent dans des fins de manche jouées au hasard
+* @param[in,out] p: La partie en cours
+* @note Le coup dure le temps de réflexion de la partie, REFLEXION_MONTE_CARLO si elle n'en donne pas,
+* sauf pour les deux premières lettres d'une manche, lues dans le livre d'ouvertures s'il y en a un
+* @see coupMonteCarlo, coupLivre
+*/
+void casMonteCarloSaisiR(Partie& p);
+/**
+* @brief Génère une lettre aléatoire pour le robot
 * @param[in,out] p: La partie en cours
 */
 void saisiRobot(Partie& p);
@@ -153,19 +207,19 @@ void saisiRobot(Partie& p);
 */
 void jouer(Partie& p);
 /**
-* @brief Affiche le mot tap par le joueur courant dans la partie en cours
+* @brief Affiche le mot tapé par le joueur courant dans la partie en cours
 * @param[in] p: La partie en cours
 */
 void motSaisi(Partie& p);
 /**
-* @brief Affiche l'tat de la partie en cours
+* @brief Affiche l'état de la partie en cours
 * @param[in,out] p: La partie en cours
 */
 void afficher(Partie& p);
 /**
-* @brief Fonction permettant de mettre  jour le score d'un joueur
+* @brief Fonction permettant de mettre à jour le score d'un joueur
 * @param[in] p: La partie en cours
-* @param[in] i: L'indice du joueur dont on veut mettre  jour le score
+* @param[in] i: L'indice du joueur dont on veut mettre à jour le score
 */
 void score(Partie& p, unsigned int i);
 /**
@@ -179,27 +233,27 @@ void afficheScore(Partie& p);
 */
 void ajouteScore(Partie& p);
 /**
-* @brief Rinitialiser la manche en cours
+* @brief Réinitialiser la manche en cours
 * @param[in,out] p : La partie en cours
 */
 void resetManche(Partie& p);
 /**
-* @brief Message si le mot tap par le joueur existe dans le dictionnaire
+* @brief Message si le mot tapé par le joueur existe dans le dictionnaire
 * @param[in,out] p : La partie en cours
 */
 void motExiste(Partie& p);
 /**
-* @brief Message si le mot tap par le joueur n'est pas le mme que le mot tap
+* @brief Message si le mot tapé par le joueur n'est pas le même que le mot tapé
 * @param[in,out] p : La partie en cours
 */
 void lettresDifferentes(Partie& p);
 /**
-* @brief Message si le mot tap par le joueur existe
+* @brief Message si le mot tapé par le joueur existe
 * @param[in,out] p : La partie en cours
 */
 void motExisteVerif(Partie& p);
 /**
-* @brief Message si le mot tap par le joueur n'existe pas
+* @brief Message si le mot tapé par le joueur n'existe pas
 * @param[in,out] p : La partie en cours
 */
 void motExistePas(Partie& p);
@@ -214,24 +268,34 @@ void saisirMotTapVerif(Partie& p);
 */
 void exclamation(Partie& p);
 /**
-* @brief Verifie si le caractre tap est un point d'exclamation
+* @brief Verifie si le caractère tapé est un point d'exclamation
 * @param[in] p : La partie en cours
-* @return Vrai si le dernier caractre est un point d'exclamation, faux sinon
+* @return Vrai si le dernier caractère est un point d'exclamation, faux sinon
 */
 bool ptExclamation(Partie& p);
 /**
-* @brief Verifie si les caractre tap sont les mmes que le mot tap
+* @brief Verifie si les caractère tapé sont les mêmes que le mot tapé
 * @param[in] p : La partie en cours
-* @return retourne un boolen
+* @return retourne un booléen
 */
 bool verifLettres(Partie& p);
 /**
-* @brief Cas o c'est un point d'interrogation, on fais les vrifications
+* @brief Demande au joueur précédent le mot qu'il avait en tête, après un point d'interrogation
+* @param[in,out] p : La partie en cours
+*/
+void inviterMot(Partie& p);
+/**
+* @brief Décide qui prend un quart de singe d'après le mot saisi par le joueur précédent
+* @param[in,out] p : La partie en cours
+*/
+void conclureInterrogation(Partie& p);
+/**
+* @brief Cas où c'est un point d'interrogation, on fais les vérifications
 * @param[in,out] p : La partie en cours
 */
 void verifInterrogation(Partie& p);
 /**
-* @brief Cas o c'est un point d'exclamation, on fait les vrifications
+* @brief Cas où c'est un point d'exclamation, on fait les vérifications
 * @param[in,out] p : La partie en cours
 */
 void verifExclamation(Partie& p);
@@ -246,13 +310,35 @@ void verifNormal(Partie& p);
 */
 void verification(Partie& p);
 /**
+* @brief Passe au joueur suivant
+* @param[in,out] p : La partie en cours
+*/
+void passerTour(Partie& p);
+/**
 * @brief Le jeu
 * @param[in, out] p : La partie en cours
 */
 void jouerPartie(Partie& p);
 /**
-* @brief Dtruit une partie et libre les ressources associes
-* @param[in,out] p: La partie  dtruire
+* @brief Fait avancer la partie jusqu'à ce qu'un humain doive saisir quelque chose ou qu'elle soit finie
+* @param[in,out] p : La partie en cours
+* @note Les robots jouent sans attendre. Le jeu est le même que celui de jouerPartie, qui attend les saisies sur cin.
+* @see fournirSaisie
+*/
+void avancerPartie(Partie& p);
+/**
+* @brief Donne à la partie la ligne saisie par l'humain qu'elle attend, puis la fait avancer
+* @param[in,out] p : La partie en cours, qui attend une lettre ou un mot
+* @param[in] ligne: La ligne saisie, terminée par '\0'
+* @note Comme avec cin, les blancs sont ignorés : une ligne vide laisse la partie attendre.
+* Une lettre est le premier caractère de la ligne, un mot son premier mot.
+* @see avancerPartie
+*/
+void fournirSaisie(Partie& p, const char* ligne);
+/**
+* @brief Détruit une partie et libère les ressources associées
+* @param[in,out] p: La partie à détruire
+* @note Un dictionnaire ou un jeu résolu partagé n'est pas libéré, il appartient à la partie modèle
 */
 void detruirePartie(Partie& p);
 
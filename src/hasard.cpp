@@ -0,0 +1,24 @@
+/**
+ * @file hasard.cpp
+ * @brief Composant générateur de nombres pseudo-aléatoires (xoshiro256**)
+ */
+
+#include "hasard.h"
+
+using namespace std;
+
+/**
+* @brief Initialise un générateur à partir d'une graine
+* @param[out] g: Le générateur
+* @param[in] graine: La graine, deux graines voisines donnent des suites sans rapport
+*/
+void initialiserGenerateur(Generateur& g, unsigned long long graine) {
+	// L'état est rempli par splitmix64, qui mélange la graine et ne donne jamais quatre zéros de suite
+	for (unsigned int i = 0; i < 4; ++i) {
+		graine += 0x9E3779B97F4A7C15ull;
+		unsigned long long z = graine;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		g.etat[i] = z ^ (z >> 31);
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#ifndef _HASARD_
+#define _HASARD_
+
+/**
+ * @file hasard.h
+ * @brief Entête du composant générateur de nombres pseudo-aléatoires (xoshiro256**)
+ */
+
+/**
+* @brief État d'un générateur, propre à une partie : deux parties ne partagent jamais de tirages
+*/
+struct Generateur {
+	unsigned long long etat[4]; // Jamais entièrement nul
+};
+
+/**
+* @brief Initialise un générateur à partir d'une graine
+* @param[out] g: Le générateur
+* @param[in] graine: La graine, deux graines voisines donnent des suites sans rapport
+*/
+void initialiserGenerateur(Generateur& g, unsigned long long graine);
+
+/**
+* @brief Tire un entier de 64 bits
+* @param[in,out] g: Le générateur
+* @return L'entier tiré
+*/
+inline unsigned long long tirer(Generateur& g) {
+	unsigned long long* s = g.etat;
+	unsigned long long x = s[1] * 5;
+	unsigned long long resultat = ((x << 7) | (x >> 57)) * 9;
+	unsigned long long t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = (s[3] << 45) | (s[3] >> 19);
+	return resultat;
+}
+/**
+* @brief Tire un entier uniformément entre 0 et n - 1, sans le biais d'un modulo
+* @param[in,out] g: Le générateur
+* @param[in] n: Le nombre de valeurs possibles
+* @return L'entier tiré
+* @pre n > 0
+*/
+inline unsigned int tirerBorne(Generateur& g, unsigned int n) {
+	// 32 bits tirés multipliés par n : les 32 bits hauts sont le résultat, les bas servent à rejeter le biais
+	unsigned long long m = (tirer(g) >> 32) * n;
+	if ((unsigned int)m < n) {
+		unsigned int seuil = (0u - n) % n;
+		while ((unsigned int)m < seuil) {
+			m = (tirer(g) >> 32) * n;
+		}
+	}
+	return (unsigned int)(m >> 32);
+}
+
+
+#endif // !_HASARD_
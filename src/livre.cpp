@@ -0,0 +1,127 @@
+/**
+ * @file livre.cpp
+ * @brief Composant livre d'ouvertures : les meilleures premières et deuxièmes lettres d'une manche,
+ * calculées à l'avance par livreOuvertures
+ *
+ * Au début d'une manche presque tout le dictionnaire est encore possible : c'est là qu'un robot qui cherche
+ * son coup a le plus de travail. Le jeu résolu donne ces coups une fois pour toutes ; le livre les garde
+ * pour chaque nombre de joueurs, et la partie n'a plus qu'à lire une case du fichier projeté.
+ */
+
+#include <fstream>
+#include <cstring>
+
+#include "livre.h"
+#include "solveur.h"
+
+using namespace std;
+
+/**
+* @brief Résout le jeu pour chaque nombre de joueurs et écrit les coups des préfixes de zéro et une lettre dans un livre
+* @param[in] d: Le dictionnaire, dont l'arbre est construit
+* @param[in] destination: Le chemin du fichier du livre
+* @param[in] nbThreads: Le nombre de fils d'exécution de la résolution, 0 pour un par coeur
+* @return Faux si le fichier n'a pas pu être écrit
+* @see ouvrirLivre
+*/
+bool compilerLivre(const Dico& d, const char* destination, unsigned int nbThreads) {
+	const unsigned int nbCoups = (NB_JOUEURS_LIVRE - 1) * PREFIXES_LIVRE;
+	char coups[nbCoups];
+	memset(coups, 0, nbCoups);
+	if (d.nbNoeuds > 0) {
+		const Noeud& racine = d.noeuds[0];
+		for (unsigned int nbJoueurs = 2; nbJoueurs <= NB_JOUEURS_LIVRE; ++nbJoueurs) {
+			Solution s;
+			resoudre(s, d, nbJoueurs, nbThreads);
+			char* ligne = coups + (nbJoueurs - 2) * PREFIXES_LIVRE;
+			ligne[0] = coupSolution(s, 0);
+			for (unsigned int i = racine.premierFils; i < racine.premierFils + racine.nbFils; ++i) {
+				char lettre = d.noeuds[i].lettre;
+				if (lettre >= 'A' && lettre <= 'Z') ligne[1 + lettre - 'A'] = coupSolution(s, i);
+			}
+			detruireSolution(s);
+		}
+	}
+
+	EnteteLivre entete;
+	memset(&entete, 0, sizeof(entete));
+	memcpy(entete.magique, "SINGELIV", 8);
+	entete.version = VERSION_LIVRE;
+	entete.nbJoueursMax = NB_JOUEURS_LIVRE;
+	entete.nbMot = d.nbMot;
+	entete.nbNoeuds = d.nbNoeuds;
+	entete.sommeDico = d.somme;
+
+	ofstream fichier(destination, ios::binary | ios::trunc);
+	fichier.write((const char*)&entete, sizeof(entete));
+	fichier.write(coups, nbCoups);
+	fichier.close();
+	return fichier.good();
+}
+/**
+* @brief Ouvre un livre d'ouvertures en le projetant en mémoire
+* @param[out] l: Le livre
+* @param[in] chemin: Le chemin du fichier du livre
+* @return Faux si le fichier est absent, d'une autre version ou n'a pas la taille de son entête
+* @note Les coups ne sont pas vérifiés ici : coupLivre ignore celui qui n'est ni une lettre ni '?'
+* @see compilerLivre, fermerLivre
+*/
+bool ouvrirLivre(Livre& l, const char* chemin) {
+	l.projection = nullptr;
+	l.taille = 0;
+	l.entete = nullptr;
+	l.coups = nullptr;
+
+	unsigned int taille = 0;
+	const char* debut = projeterFichier(chemin, taille);
+	if (debut == nullptr) return false;
+
+	const EnteteLivre* entete = (const EnteteLivre*)debut; // La projection est alignée sur une page
+	bool valide = taille >= sizeof(EnteteLivre) && memcmp(entete->magique, "SINGELIV", 8) == 0
+		&& entete->version == VERSION_LIVRE && entete->nbJoueursMax >= 2 && entete->nbJoueursMax <= 255
+		&& (unsigned long long)taille == sizeof(EnteteLivre) + (unsigned long long)(entete->nbJoueursMax - 1) * PREFIXES_LIVRE;
+	if (!valide) {
+		libererProjection(debut, taille);
+		return false;
+	}
+
+	l.projection = debut;
+	l.taille = taille;
+	l.entete = entete;
+	l.coups = debut + sizeof(EnteteLivre);
+	return true;
+}
+/**
+* @brief Donne la lettre du livre après le mot tapé
+* @param[in] l: Le livre
+* @param[in] d: Le dictionnaire de la partie
+* @param[in] nbJoueurs: Le nombre de joueurs de la partie
+* @param[in] motTap: Le mot tapé
+* @return La lettre ou '?', '\0' si le livre ne la connaît pas : mot tapé de plus d'une lettre, nombre de joueurs
+* hors du livre, livre calculé sur un autre dictionnaire, ou coup du livre qui n'est ni une lettre ni '?'
+*/
+char coupLivre(const Livre& l, const Dico& d, unsigned int nbJoueurs, const char* motTap) {
+	if (l.projection == nullptr || nbJoueurs < 2 || nbJoueurs > l.entete->nbJoueursMax) return '\0';
+	if (l.entete->nbMot != d.nbMot || l.entete->nbNoeuds != d.nbNoeuds || l.entete->sommeDico != d.somme) return '\0';
+
+	const char* ligne = l.coups + (nbJoueurs - 2) * PREFIXES_LIVRE;
+	char coup;
+	if (motTap[0] == '\0') coup = ligne[0];
+	else if (motTap[1] != '\0' || motTap[0] < 'A' || motTap[0] > 'Z') return '\0';
+	else coup = ligne[1 + motTap[0] - 'A'];
+
+	// Un coup abîmé dans le fichier est laissé au robot, les autres coups du livre restent joués
+	if (coup != '?' && (coup < 'A' || coup > 'Z')) return '\0';
+	return coup;
+}
+/**
+* @brief Ferme un livre d'ouvertures
+* @param[in,out] l: Le livre
+*/
+void fermerLivre(Livre& l) {
+	if (l.projection != nullptr) libererProjection(l.projection, l.taille);
+	l.projection = nullptr;
+	l.taille = 0;
+	l.entete = nullptr;
+	l.coups = nullptr;
+}
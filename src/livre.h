@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef _LIVRE_
+#define _LIVRE_
+
+/**
+ * @file livre.h
+ * @brief Entête du composant livre d'ouvertures : les meilleures premières et deuxièmes lettres d'une manche,
+ * calculées à l'avance par livreOuvertures
+ */
+
+#include "dico.h"
+
+ /**
+ * @brief Les constantes du livre d'ouvertures
+ */
+enum {
+	VERSION_LIVRE = 3, // Version du format binaire du livre
+	NB_JOUEURS_LIVRE = 8, // Le livre couvre les parties de 2 à NB_JOUEURS_LIVRE joueurs
+	PREFIXES_LIVRE = 27, // Par nombre de joueurs : le préfixe vide, puis les préfixes d'une lettre de 'A' à 'Z'
+};
+
+/**
+* @brief Entête du fichier du livre, suivi des coups : PREFIXES_LIVRE par nombre de joueurs, de 2 à nbJoueursMax
+*/
+struct EnteteLivre {
+	char magique[8]; // "SINGELIV"
+	unsigned int version;
+	unsigned int nbJoueursMax;
+	unsigned int nbMot; // Le dictionnaire résolu, le livre ne sert qu'avec lui
+	unsigned int nbNoeuds;
+	unsigned int sommeDico; // Somme de contrôle de son fichier binaire, 0 s'il a été lu dans le texte
+};
+/**
+* @brief Livre d'ouvertures projeté en mémoire
+*/
+struct Livre {
+	const char* projection; // Début du fichier projeté, nullptr si le livre n'est pas ouvert
+	unsigned int taille;
+	const EnteteLivre* entete;
+	const char* coups; // Lettre ou '?' à jouer par nombre de joueurs et préfixe, '\0' si aucun mot ne commence par le préfixe
+};
+
+/**
+* @brief Résout le jeu pour chaque nombre de joueurs et écrit les coups des préfixes de zéro et une lettre dans un livre
+* @param[in] d: Le dictionnaire, dont l'arbre est construit
+* @param[in] destination: Le chemin du fichier du livre
+* @param[in] nbThreads: Le nombre de fils d'exécution de la résolution, 0 pour un par coeur
+* @return Faux si le fichier n'a pas pu être écrit
+* @see ouvrirLivre
+*/
+bool compilerLivre(const Dico& d, const char* destination, unsigned int nbThreads);
+/**
+* @brief Ouvre un livre d'ouvertures en le projetant en mémoire
+* @param[out] l: Le livre
+* @param[in] chemin: Le chemin du fichier du livre
+* @return Faux si le fichier est absent, d'une autre version ou n'a pas la taille de son entête
+* @note Les coups ne sont pas vérifiés ici : coupLivre ignore celui qui n'est ni une lettre ni '?'
+* @see compilerLivre, fermerLivre
+*/
+bool ouvrirLivre(Livre& l, const char* chemin);
+/**
+* @brief Donne la lettre du livre après le mot tapé
+* @param[in] l: Le livre
+* @param[in] d: Le dictionnaire de la partie
+* @param[in] nbJoueurs: Le nombre de joueurs de la partie
+* @param[in] motTap: Le mot tapé
+* @return La lettre ou '?', '\0' si le livre ne la connaît pas : mot tapé de plus d'une lettre, nombre de joueurs
+* hors du livre, livre calculé sur un autre dictionnaire, ou coup du livre qui n'est ni une lettre ni '?'
+*/
+char coupLivre(const Livre& l, const Dico& d, unsigned int nbJoueurs, const char* motTap);
+/**
+* @brief Ferme un livre d'ouvertures
+* @param[in,out] l: Le livre
+*/
+void fermerLivre(Livre& l);
+
+
+#endif // !_LIVRE_
@@ -0,0 +1,52 @@
+/**
+ * @file livreOuvertures.cpp
+ * @brief Calcule le livre d'ouvertures projeté par le jeu : la meilleure première et deuxième lettre d'une manche
+ * pour chaque nombre de joueurs, d'après le jeu résolu
+ *
+ * Compilation : g++ -O2 -std=c++17 -pthread dico.cpp table.cpp solveur.cpp registre.cpp statistiques.cpp livre.cpp livreOuvertures.cpp -o livreOuvertures
+ * Utilisation : livreOuvertures [fichier de mots] [fichier du livre]
+ */
+
+#include <iostream>
+
+#include "dico.h"
+#include "registre.h"
+#include "livre.h"
+
+using namespace std;
+
+int main(int argc, const char* argv[]) {
+	const char* source = (argc > 1) ? argv[1] : "./ods4.txt";
+	const char* destination = (argc > 2) ? argv[2] : "./ods4.livre";
+
+	// Le livre vaut pour le dictionnaire que le jeu projette : le binaire compilé à côté du fichier de mots
+	char* binaire = cheminBinaire(source);
+	Dico* d = prendreDico(source, binaire);
+	delete[] binaire;
+	if (d->nbMot == 0) {
+		cout << "Dico pas ouvert : " << source << endl;
+		rendreDico(d);
+		viderRegistre();
+		return 2;
+	}
+
+	bool ecrit = compilerLivre(*d, destination, 0);
+	rendreDico(d);
+	viderRegistre();
+	if (!ecrit) {
+		cout << "Impossible d'écrire " << destination << endl;
+		return 2;
+	}
+
+	Livre l;
+	if (!ouvrirLivre(l, destination)) {
+		cout << "Le fichier " << destination << " ne se relit pas" << endl;
+		return 1;
+	}
+	cout << destination << " : " << l.entete->nbJoueursMax - 1 << " nombres de joueurs, version " << VERSION_LIVRE << endl;
+	for (unsigned int nbJoueurs = 2; nbJoueurs <= l.entete->nbJoueursMax; ++nbJoueurs) {
+		cout << nbJoueurs << " joueurs : " << l.coups[(nbJoueurs - 2) * PREFIXES_LIVRE] << endl;
+	}
+	fermerLivre(l);
+	return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file montecarlo.cpp
+ * @brief Composant robot Monte-Carlo : chaque lettre possible est jugée sur des fins de manche jouées au hasard
+ *
+ * Après chaque lettre qui peut suivre le mot tapé, les fils d'exécution du robot jouent la fin de la manche
+ * comme la jouerait le robot 'R', jusqu'à ce que le budget du coup soit écoulé, et comptent les manches
+ * perdues par le robot. Plus il y a de coeurs, plus il y a de fins de manche jouées dans le même budget.
+ * Les fils ne font que lire le dictionnaire, chacun a son générateur, et ils ne partagent leurs comptes qu'à la fin du coup.
+ * Chaque pool cherche un coup à la fois : des parties qui doivent chercher en même temps ont chacune le leur,
+ * ou cherchent sans pool, sur leur propre fil d'exécution.
+ */
+
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+
+#include "montecarlo.h"
+#include "hasard.h"
+#include "statistiques.h"
+
+using namespace std;
+
+/**
+* @brief Un coup à chercher
+*/
+struct RechercheMonteCarlo {
+	const Dico* d;
+	unsigned int nbJoueurs;
+	unsigned int profondeur; // Nombre de lettres après celle jouée par le robot
+	unsigned int premierCandidat; // Noeud de la première lettre possible, les suivantes suivent
+	unsigned int nbCandidats;
+	chrono::steady_clock::time_point echeance;
+	unsigned long long graine;
+};
+
+/**
+* @brief Les fils d'exécution d'un robot et le coup qu'ils cherchent
+*/
+struct PoolMonteCarlo {
+	mutex unCoup; // Un seul coup cherché à la fois par le pool
+	mutex verrou; // Protège tout ce qui suit
+	condition_variable travail; // Signalée quand un coup est à chercher ou que le pool s'arrête
+	condition_variable fin; // Signalée quand le dernier fil a fini sa part du coup
+	thread* fils;
+	unsigned int nbFils;
+	unsigned long long numeroCoup; // Change à chaque coup à chercher
+	bool arret;
+	unsigned int nbActifs; // Fils qui n'ont pas fini leur part du coup en cours
+	RechercheMonteCarlo recherche; // Le coup en cours
+	unsigned long long essais[MAX_CANDIDATS]; // Fins de manche jouées après chaque lettre possible
+	unsigned long long pertes[MAX_CANDIDATS]; // Celles que le robot a perdues
+};
+
+/**
+* @brief Joue une fin de manche au hasard, chaque joueur comme le robot 'R'
+* @param[in] d: Le dictionnaire
+* @param[in] noeud: Le noeud de la lettre jouée par le robot
+* @param[in] profondeur: La longueur du préfixe du noeud
+* @param[in] nbJoueurs: Le nombre de joueurs
+* @param[in,out] g: Le générateur du fil d'exécution
+* @return Le joueur qui perd la manche, compté à partir du robot (0 = lui)
+*/
+static unsigned int finAuHasard(const Dico& d, unsigned int noeud, unsigned int profondeur, unsigned int nbJoueurs, Generateur& g) {
+	unsigned int joueur = 0; // Celui qui a tapé la dernière lettre
+	for (;;) {
+		const Noeud& n = d.noeuds[noeud];
+		// Former un mot de plus de deux lettres fait perdre, un préfixe sans suite aussi : le joueur suivant le conteste
+		if ((n.estMot && profondeur > 2) || n.nbFils == 0) return joueur;
+
+		// Une lettre tirée selon le nombre de mots qui continuent par elle, parmi celles qui ne forment pas un mot s'il y en a
+		const Noeud* fils = d.noeuds + n.premierFils;
+		unsigned int nbSuite = 0, nbSurs = 0;
+		for (unsigned int i = 0; i < n.nbFils; ++i) {
+			nbSuite += fils[i].nbMots;
+			if (!fils[i].estMot || profondeur + 1 <= 2) nbSurs += fils[i].nbMots;
+		}
+		bool surs = nbSurs > 0;
+		unsigned int tirage = tirerBorne(g, surs ? nbSurs : nbSuite);
+		unsigned int choisi = 0;
+		for (;; ++choisi) {
+			if (surs && fils[choisi].estMot && profondeur + 1 > 2) continue;
+			if (tirage < fils[choisi].nbMots) break;
+			tirage -= fils[choisi].nbMots;
+		}
+
+		noeud = n.premierFils + choisi;
+		++profondeur;
+		joueur = (joueur + 1) % nbJoueurs;
+	}
+}
+/**
+* @brief Joue des fins de manche après les lettres possibles d'un coup, jusqu'à son échéance
+* @param[in] r: Le coup cherché
+* @param[in] t: Le numéro du fil d'exécution, qui choisit sa graine et sa première lettre
+* @param[in,out] essais: Les fins de manche jouées après chaque lettre, augmentées
+* @param[in,out] pertes: Celles que le robot a perdues, augmentées
+*/
+static void jouerFins(const RechercheMonteCarlo& r, unsigned int t, unsigned long long essais[], unsigned long long pertes[]) {
+	Generateur g;
+	initialiserGenerateur(g, r.graine + t);
+
+	// Chaque fil commence par une lettre différente et regarde l'heure après chaque lot, même avant d'avoir
+	// passé sur toutes les lettres : le budget est tenu quand il y a beaucoup de lettres possibles
+	unsigned int k = t % r.nbCandidats;
+	do {
+		for (unsigned int i = 0; i < FINS_PAR_LOT; ++i) {
+			pertes[k] += (finAuHasard(*r.d, r.premierCandidat + k, r.profondeur, r.nbJoueurs, g) == 0);
+		}
+		essais[k] += FINS_PAR_LOT;
+		k = (k + 1 == r.nbCandidats) ? 0 : k + 1;
+	} while (chrono::steady_clock::now() < r.echeance);
+}
+/**
+* @brief Boucle d'un fil d'exécution du pool : joue des fins de manche pour chaque coup cherché
+* @param[in,out] pl: Le pool du fil
+* @param[in] t: Le numéro du fil
+*/
+static void travailler(PoolMonteCarlo& pl, unsigned int t) {
+	unsigned long long vu = 0;
+	unique_lock<mutex> garde(pl.verrou);
+	for (;;) {
+		while (!pl.arret && pl.numeroCoup == vu) pl.travail.wait(garde);
+		if (pl.arret) return;
+		vu = pl.numeroCoup;
+		RechercheMonteCarlo r = pl.recherche;
+		garde.unlock();
+
+		unsigned long long essais[MAX_CANDIDATS] = {}, pertes[MAX_CANDIDATS] = {};
+		jouerFins(r, t, essais, pertes);
+
+		garde.lock();
+		for (unsigned int i = 0; i < r.nbCandidats; ++i) {
+			pl.essais[i] += essais[i];
+			pl.pertes[i] += pertes[i];
+		}
+		if (--pl.nbActifs == 0) pl.fin.notify_all();
+	}
+}
+/**
+* @brief Démarre un pool de fils d'exécution pour le robot Monte-Carlo
+* @param[in] nbFils: Le nombre de fils, 0 pour un par coeur
+* @return Le pool, à arrêter par arreterPoolMonteCarlo
+*/
+PoolMonteCarlo* demarrerPoolMonteCarlo(unsigned int nbFils) {
+	if (nbFils == 0) nbFils = thread::hardware_concurrency();
+	if (nbFils == 0) nbFils = 1;
+	PoolMonteCarlo* pl = new PoolMonteCarlo;
+	pl->nbFils = nbFils;
+	pl->numeroCoup = 0;
+	pl->arret = false;
+	pl->nbActifs = 0;
+	pl->fils = new thread[nbFils];
+	for (unsigned int t = 0; t < nbFils; ++t) {
+		pl->fils[t] = thread(travailler, ref(*pl), t);
+	}
+	return pl;
+}
+/**
+* @brief Choisit la lettre qui fait perdre le moins souvent le joueur, d'après des fins de manche jouées au hasard
+* par les fils d'exécution d'un pool, ou par le fil appelant
+* @param[in,out] pl: Le pool qui cherche le coup, nullptr pour le chercher sur le fil appelant
+* @param[in] d: Le dictionnaire, dont l'arbre est construit, seulement lu
+* @param[in] noeud: Le noeud du mot tapé, AUCUN_NOEUD si aucun mot ne le commence
+* @param[in] profondeur: Le nombre de lettres du mot tapé
+* @param[in] nbJoueurs: Le nombre de joueurs de la partie
+* @param[in] budget: Le temps du coup, en ns
+* @param[in] graine: La graine des tirages, chaque fil d'exécution en tire la sienne
+* @return La lettre, ou '?' s'il fait perdre le joueur précédent ou si aucune lettre ne continue un mot
+* @note Un pool cherche un coup à la fois, les parties qui lui en demandent un en même temps attendent
+*/
+char coupMonteCarlo(PoolMonteCarlo* pl, const Dico& d, unsigned int noeud, unsigned int profondeur, unsigned int nbJoueurs,
+	unsigned long long budget, unsigned long long graine) {
+	if (noeud == AUCUN_NOEUD || d.noeuds[noeud].nbFils == 0) return '?';
+
+	// Le '?' est jugé sans fin de manche, comme dans perdantInterrogation : contester une ou deux lettres fait perdre
+	// le précédent. Contester un préfixe plus long, qui commence un mot, fait perdre le robot : aucune lettre n'est pire
+	if (profondeur >= 1 && profondeur <= 2) return '?';
+	const Noeud& n = d.noeuds[noeud];
+
+	RechercheMonteCarlo r;
+	r.d = &d;
+	r.nbJoueurs = nbJoueurs;
+	r.profondeur = profondeur + 1;
+	r.premierCandidat = n.premierFils;
+	r.nbCandidats = n.nbFils;
+	// Le dernier seizième du budget est laissé au réveil des fils et au choix de la lettre
+	r.echeance = chrono::steady_clock::now() + chrono::nanoseconds(budget - budget / 16);
+	r.graine = graine;
+
+	unsigned long long essais[MAX_CANDIDATS] = {}, pertes[MAX_CANDIDATS] = {};
+	if (pl == nullptr) {
+		jouerFins(r, 0, essais, pertes);
+	}
+	else {
+		lock_guard<mutex> unSeul(pl->unCoup);
+		unique_lock<mutex> garde(pl->verrou);
+		pl->recherche = r;
+		for (unsigned int i = 0; i < n.nbFils; ++i) {
+			pl->essais[i] = 0;
+			pl->pertes[i] = 0;
+		}
+		pl->nbActifs = pl->nbFils;
+		++pl->numeroCoup;
+		pl->travail.notify_all();
+		while (pl->nbActifs > 0) pl->fin.wait(garde);
+		for (unsigned int i = 0; i < n.nbFils; ++i) {
+			essais[i] = pl->essais[i];
+			pertes[i] = pl->pertes[i];
+		}
+	}
+
+	// Le taux de défaites le plus bas, à égalité la lettre qui laisse le plus de mots.
+	// Les lettres qu'aucun fil n'a eu le temps d'essayer ne sont pas jugées : chaque fil en a essayé au moins une
+	unsigned int meilleur = 0;
+	while (essais[meilleur] == 0) ++meilleur;
+	unsigned long long total = 0;
+	for (unsigned int i = 0; i < n.nbFils; ++i) {
+		total += essais[i];
+		if (essais[i] == 0 || i == meilleur) continue;
+		unsigned long long gauche = pertes[i] * essais[meilleur], droite = pertes[meilleur] * essais[i];
+		if (gauche < droite || (gauche == droite && d.noeuds[n.premierFils + i].nbMots > d.noeuds[n.premierFils + meilleur].nbMots)) {
+			meilleur = i;
+		}
+	}
+	COMPTER(nbCoupsMonteCarlo, 1);
+	COMPTER(nbFinsMonteCarlo, total);
+	return d.noeuds[n.premierFils + meilleur].lettre;
+}
+/**
+* @brief Arrête les fils d'exécution d'un pool et le libère
+* @param[in,out] pl: Le pool, démarré par demarrerPoolMonteCarlo, ou nullptr
+* @pre Aucun coup n'est en cours de recherche par le pool
+*/
+void arreterPoolMonteCarlo(PoolMonteCarlo* pl) {
+	if (pl == nullptr) return;
+	{
+		lock_guard<mutex> garde(pl->verrou);
+		pl->arret = true;
+	}
+	pl->travail.notify_all();
+	for (unsigned int t = 0; t < pl->nbFils; ++t) {
+		pl->fils[t].join();
+	}
+	delete[] pl->fils;
+	delete pl;
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#ifndef _MONTECARLO_
+#define _MONTECARLO_
+
+/**
+ * @file montecarlo.h
+ * @brief Entête du composant robot Monte-Carlo : chaque lettre possible est jugée sur des fins de manche jouées au hasard
+ */
+
+#include "dico.h"
+
+ /**
+ * @brief Les constantes du robot Monte-Carlo
+ */
+enum {
+	REFLEXION_MONTE_CARLO = 20000000, // Temps d'un coup en ns quand la partie n'en donne pas
+	FINS_PAR_LOT = 32, // Fins de manche jouées pour une lettre avant de regarder l'heure
+	MAX_CANDIDATS = 256, // Lettres possibles après un mot au plus : une par valeur d'octet, accents compris
+};
+
+/**
+* @brief Les fils d'exécution d'un robot Monte-Carlo, qui cherchent ensemble un coup à la fois
+*/
+struct PoolMonteCarlo;
+
+/**
+* @brief Démarre un pool de fils d'exécution pour le robot Monte-Carlo
+* @param[in] nbFils: Le nombre de fils, 0 pour un par coeur
+* @return Le pool, à arrêter par arreterPoolMonteCarlo
+*/
+PoolMonteCarlo* demarrerPoolMonteCarlo(unsigned int nbFils);
+/**
+* @brief Choisit la lettre qui fait perdre le moins souvent le joueur, d'après des fins de manche jouées au hasard
+* par les fils d'exécution d'un pool, ou par le fil appelant
+* @param[in,out] pl: Le pool qui cherche le coup, nullptr pour le chercher sur le fil appelant
+* @param[in] d: Le dictionnaire, dont l'arbre est construit, seulement lu
+* @param[in] noeud: Le noeud du mot tapé, AUCUN_NOEUD si aucun mot ne le commence
+* @param[in] profondeur: Le nombre de lettres du mot tapé
+* @param[in] nbJoueurs: Le nombre de joueurs de la partie
+* @param[in] budget: Le temps du coup, en ns
+* @param[in] graine: La graine des tirages, chaque fil d'exécution en tire la sienne
+* @return La lettre, ou '?' s'il fait perdre le joueur précédent ou si aucune lettre ne continue un mot
+* @note Un pool cherche un coup à la fois, les parties qui lui en demandent un en même temps attendent
+*/
+char coupMonteCarlo(PoolMonteCarlo* pl, const Dico& d, unsigned int noeud, unsigned int profondeur, unsigned int nbJoueurs,
+	unsigned long long budget, unsigned long long graine);
+/**
+* @brief Arrête les fils d'exécution d'un pool et le libère
+* @param[in,out] pl: Le pool, démarré par demarrerPoolMonteCarlo, ou nullptr
+* @pre Aucun coup n'est en cours de recherche par le pool
+*/
+void arreterPoolMonteCarlo(PoolMonteCarlo* pl);
+
+
+#endif // !_MONTECARLO_
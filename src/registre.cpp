@@ -0,0 +1,259 @@
+/**
+ * @file registre.cpp
+ * @brief Composant registre des dictionnaires chargés, partagés par toutes les parties du processus
+ *
+ * Lire le fichier de mots et construire l'arbre et la table coûte bien plus qu'une partie.
+ * Un processus qui enchaîne les parties, ou en joue plusieurs à la fois, ne le fait qu'une fois par fichier :
+ * les parties suivantes reprennent le dictionnaire déjà chargé, tant que le fichier et son dictionnaire compilé
+ * gardent la même date de modification.
+ * Le chargement se fait sur un fil à part : la partie commence aussitôt, et n'attend le dictionnaire
+ * que lorsqu'elle doit vraiment le lire.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <climits>
+#include <mutex>
+#include <condition_variable>
+
+#include <sys/stat.h>
+
+#include "registre.h"
+#include "table.h"
+#include "statistiques.h"
+
+using namespace std;
+
+#ifdef _WIN32
+#define TAILLE_CHEMIN _MAX_PATH
+#else
+#define TAILLE_CHEMIN PATH_MAX
+#endif
+
+static mutex verrou; // Protège tout le registre : les parties de plusieurs fils d'exécution s'y servent
+static condition_variable chargement; // Signalée quand un dictionnaire devient prêt
+static EntreeRegistre* entrees = nullptr;
+static StatistiquesRegistre statistiques = { 0, 0, 0 };
+static void (*avertissement)(void*) = nullptr; // Appelée quand un dictionnaire devient prêt
+static void* contexteAvertissement = nullptr;
+
+/**
+* @brief Donne le chemin absolu d'un fichier, qui sert de clé au registre
+* @param[in] chemin: Le chemin du fichier
+* @param[out] absolu: Le chemin absolu, de TAILLE_CHEMIN caractères au plus, ou chemin s'il n'a pas pu être résolu
+*/
+static void cheminAbsolu(const char* chemin, char* absolu) {
+#ifdef _WIN32
+	bool resolu = _fullpath(absolu, chemin, TAILLE_CHEMIN) != nullptr;
+#else
+	bool resolu = realpath(chemin, absolu) != nullptr;
+#endif
+	if (!resolu) {
+		strncpy(absolu, chemin, TAILLE_CHEMIN - 1);
+		absolu[TAILLE_CHEMIN - 1] = '\0';
+	}
+}
+/**
+* @brief Donne la date de modification d'un fichier
+* @param[in] chemin: Le chemin du fichier
+* @return La date en ns (à la seconde près sous Windows), 0 si le fichier est absent
+*/
+static long long dateModification(const char* chemin) {
+	struct stat infos;
+	if (stat(chemin, &infos) != 0) return 0;
+#if defined(_WIN32)
+	return (long long)infos.st_mtime * 1000000000;
+#elif defined(__APPLE__)
+	return (long long)infos.st_mtimespec.tv_sec * 1000000000 + infos.st_mtimespec.tv_nsec;
+#else
+	return (long long)infos.st_mtim.tv_sec * 1000000000 + infos.st_mtim.tv_nsec;
+#endif
+}
+/**
+* @brief Libère une entrée du registre et son dictionnaire
+* @param[in,out] precedente: Le lien vers l'entrée, modifié pour la sauter
+*/
+static void libererEntree(EntreeRegistre*& precedente) {
+	EntreeRegistre* e = precedente;
+	precedente = e->suivante;
+	if (e->chargeur.joinable()) e->chargeur.join(); // Prêt : le fil a fini ou va finir
+	detruireDico(*e->d);
+	delete e->d;
+	delete[] e->cheminBinaire;
+	delete[] e->chemin;
+	delete e;
+	--statistiques.nbDicos;
+}
+/**
+* @brief Charge le dictionnaire d'une entrée et le rend prêt, sur le fil de chargement
+* @param[in,out] e: L'entrée, dont le dictionnaire est alloué
+*/
+static void chargerEntree(EntreeRegistre* e) {
+	Dico& d = *e->d;
+	DEBUT_MESURE(debut);
+	if (!chargerDicoBinaire(d, e->cheminBinaire, e->chemin)) { // Compilé par compilDico
+		if (!projeterDico(d, e->chemin)) chargerDico(d, e->chemin); // Vide si le fichier n'a pas pu être lu
+	}
+	// Le dictionnaire binaire apporte son arbre et sa table, le fichier texte doit les construire
+	if (d.noeuds == nullptr) construireArbre(d);
+	if (d.filtre == nullptr) construireTable(d); // Sinon estMotValide cherche dans la zone des mots
+	COMPTER(nbChargements, 1);
+	COMPTER(nbMotsCharges, d.nbMot);
+#if STATISTIQUES
+	if (statistiquesActives) statistiquesFil().nsChargement += horlogeNs() - debut;
+#endif
+	{
+		lock_guard<mutex> garde(verrou);
+		e->pret = true;
+		if (avertissement != nullptr) avertissement(contexteAvertissement);
+	}
+	chargement.notify_all();
+}
+/**
+* @brief Donne le dictionnaire d'un fichier de mots sans attendre qu'il soit chargé : il l'est en arrière-plan
+* @param[in] chemin: Le chemin du fichier de mots
+* @param[in] cheminBinaire: Le chemin du dictionnaire compilé par compilDico, essayé en premier
+* @return Le dictionnaire, qu'il ne faut pas lire avant que attendreDico l'ait rendu prêt
+* @note Un fichier déjà demandé n'est chargé qu'une fois par processus tant que ni lui ni son dictionnaire compilé ne changent.
+* Le dictionnaire est partagé : il ne doit pas être modifié, et doit être rendu par rendreDico
+* @see attendreDico, rendreDico
+*/
+Dico* demanderDico(const char* chemin, const char* cheminBinaire) {
+	// La clé est le chemin absolu et les dates de modification du fichier de mots et du dictionnaire compilé :
+	// un fichier modifié, ou recompilé par compilDico, est rechargé
+	char absolu[TAILLE_CHEMIN];
+	cheminAbsolu(chemin, absolu);
+	long long modification = dateModification(absolu);
+	long long modificationBinaire = dateModification(cheminBinaire);
+
+	lock_guard<mutex> garde(verrou);
+	for (EntreeRegistre* e = entrees; e != nullptr; e = e->suivante) {
+		if (!e->perime && e->modification == modification && e->modificationBinaire == modificationBinaire
+			&& strcmp(e->chemin, absolu) == 0) {
+			++e->nbReferences;
+			++statistiques.nbReutilisations;
+			return e->d; // Peut-être encore en chargement
+		}
+	}
+
+	// Les versions précédentes du fichier ne serviront plus à de nouvelles parties
+	for (EntreeRegistre** lien = &entrees; *lien != nullptr;) {
+		if (strcmp((*lien)->chemin, absolu) == 0) {
+			(*lien)->perime = true;
+			if ((*lien)->nbReferences == 0 && (*lien)->pret) {
+				libererEntree(*lien);
+				continue;
+			}
+		}
+		lien = &(*lien)->suivante;
+	}
+
+	EntreeRegistre* e = new EntreeRegistre;
+	e->chemin = new char[strlen(absolu) + 1];
+	strcpy(e->chemin, absolu);
+	e->cheminBinaire = new char[strlen(cheminBinaire) + 1];
+	strcpy(e->cheminBinaire, cheminBinaire);
+	e->modification = modification;
+	e->modificationBinaire = modificationBinaire;
+	e->d = new Dico;
+	e->nbReferences = 1;
+	e->perime = false;
+	e->pret = false;
+	e->suivante = entrees;
+	entrees = e;
+	++statistiques.nbChargements;
+	++statistiques.nbDicos;
+	e->chargeur = thread(chargerEntree, e);
+	return e->d;
+}
+/**
+* @brief Attend qu'un dictionnaire demandé soit chargé, avec son arbre et sa table
+* @param[in] d: Le dictionnaire, vide une fois prêt si le fichier n'a pas pu être lu
+*/
+void attendreDico(const Dico* d) {
+	unique_lock<mutex> garde(verrou);
+	for (EntreeRegistre* e = entrees; e != nullptr; e = e->suivante) {
+		if (e->d == d) {
+			while (!e->pret) chargement.wait(garde);
+			return;
+		}
+	}
+}
+/**
+* @brief Vérifie, sans attendre, si un dictionnaire demandé est chargé
+* @param[in] d: Le dictionnaire
+* @return Vrai s'il est prêt : attendreDico le rend alors aussitôt
+*/
+bool dicoPret(const Dico* d) {
+	lock_guard<mutex> garde(verrou);
+	for (EntreeRegistre* e = entrees; e != nullptr; e = e->suivante) {
+		if (e->d == d) return e->pret;
+	}
+	return true;
+}
+/**
+* @brief Donne la fonction appelée chaque fois qu'un dictionnaire devient prêt, pour réveiller une boucle d'évènements
+* @param[in] avertir: La fonction, appelée sur le fil de chargement registre verrouillé : elle doit être brève
+* et ne pas se servir du registre. nullptr pour ne plus être averti
+* @param[in] contexte: La valeur passée à la fonction
+*/
+void avertirChargements(void (*avertir)(void* contexte), void* contexte) {
+	lock_guard<mutex> garde(verrou);
+	avertissement = avertir;
+	contexteAvertissement = contexte;
+}
+/**
+* @brief Donne le dictionnaire d'un fichier de mots, chargé une seule fois par processus tant que le fichier ne change pas
+* @param[in] chemin: Le chemin du fichier de mots
+* @param[in] cheminBinaire: Le chemin du dictionnaire compilé par compilDico, essayé en premier
+* @return Le dictionnaire prêt, avec son arbre et sa table, vide si le fichier n'a pas pu être lu
+* @note Le dictionnaire est partagé : il ne doit pas être modifié, et doit être rendu par rendreDico
+* @see demanderDico, rendreDico
+*/
+Dico* prendreDico(const char* chemin, const char* cheminBinaire) {
+	Dico* d = demanderDico(chemin, cheminBinaire);
+	attendreDico(d);
+	return d;
+}
+/**
+* @brief Rend un dictionnaire pris au registre
+* @param[in] d: Le dictionnaire
+* @note Un dictionnaire qui n'est plus utilisé reste chargé pour les parties suivantes,
+* sauf si son fichier a changé depuis : il est alors libéré
+*/
+void rendreDico(const Dico* d) {
+	lock_guard<mutex> garde(verrou);
+	for (EntreeRegistre** lien = &entrees; *lien != nullptr; lien = &(*lien)->suivante) {
+		if ((*lien)->d == d) {
+			if (--(*lien)->nbReferences == 0 && (*lien)->perime && (*lien)->pret) libererEntree(*lien);
+			return;
+		}
+	}
+}
+/**
+* @brief Libère les dictionnaires qu'aucune partie n'utilise, après avoir attendu les chargements en cours
+*/
+void viderRegistre() {
+	unique_lock<mutex> garde(verrou);
+	for (EntreeRegistre* e = entrees; e != nullptr;) {
+		if (e->pret) {
+			e = e->suivante;
+		}
+		else {
+			chargement.wait(garde);
+			e = entrees; // Le registre a pu changer pendant l'attente
+		}
+	}
+	for (EntreeRegistre** lien = &entrees; *lien != nullptr;) {
+		if ((*lien)->nbReferences == 0) libererEntree(*lien);
+		else lien = &(*lien)->suivante;
+	}
+}
+/**
+* @brief Donne les compteurs du registre
+* @return Les compteurs
+*/
+StatistiquesRegistre statistiquesRegistre() {
+	lock_guard<mutex> garde(verrou);
+	return statistiques;
+}
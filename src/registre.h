@@ -0,0 +1,94 @@
+#pragma once
+
+#ifndef _REGISTRE_
+#define _REGISTRE_
+
+/**
+ * @file registre.h
+ * @brief Entête du composant registre des dictionnaires chargés, partagés par toutes les parties du processus
+ */
+
+#include <thread>
+
+#include "dico.h"
+
+/**
+* @brief Un dictionnaire chargé, avec le fichier dont il vient
+*/
+struct EntreeRegistre {
+	char* chemin; // Chemin absolu du fichier de mots
+	char* cheminBinaire; // Chemin du dictionnaire compilé, essayé en premier
+	long long modification; // Date de modification du fichier au chargement, en ns, 0 s'il était absent
+	long long modificationBinaire; // Date de modification du dictionnaire compilé au chargement, en ns, 0 s'il était absent
+	Dico* d; // Arbre et table construits
+	unsigned int nbReferences; // Parties qui utilisent le dictionnaire
+	bool perime; // Le fichier a changé depuis : libéré dès qu'aucune partie ne l'utilise
+	bool pret; // Faux tant que le fil de chargement n'a pas fini
+	std::thread chargeur; // Fil qui charge le dictionnaire en arrière-plan
+	EntreeRegistre* suivante;
+};
+/**
+* @brief Ce que le registre a fait depuis le démarrage du processus
+*/
+struct StatistiquesRegistre {
+	unsigned long long nbChargements; // Dictionnaires lus sur le disque
+	unsigned long long nbReutilisations; // Demandes servies par un dictionnaire déjà chargé
+	unsigned int nbDicos; // Dictionnaires gardés en mémoire
+};
+
+/**
+* @brief Donne le dictionnaire d'un fichier de mots sans attendre qu'il soit chargé : il l'est en arrière-plan
+* @param[in] chemin: Le chemin du fichier de mots
+* @param[in] cheminBinaire: Le chemin du dictionnaire compilé par compilDico, essayé en premier
+* @return Le dictionnaire, qu'il ne faut pas lire avant que attendreDico l'ait rendu prêt
+* @note Un fichier déjà demandé n'est chargé qu'une fois par processus tant que ni lui ni son dictionnaire compilé ne changent.
+* Le dictionnaire est partagé : il ne doit pas être modifié, et doit être rendu par rendreDico
+* @see attendreDico, rendreDico
+*/
+Dico* demanderDico(const char* chemin, const char* cheminBinaire);
+/**
+* @brief Attend qu'un dictionnaire demandé soit chargé, avec son arbre et sa table
+* @param[in] d: Le dictionnaire, vide une fois prêt si le fichier n'a pas pu être lu
+*/
+void attendreDico(const Dico* d);
+/**
+* @brief Vérifie, sans attendre, si un dictionnaire demandé est chargé
+* @param[in] d: Le dictionnaire
+* @return Vrai s'il est prêt : attendreDico le rend alors aussitôt
+*/
+bool dicoPret(const Dico* d);
+/**
+* @brief Donne la fonction appelée chaque fois qu'un dictionnaire devient prêt, pour réveiller une boucle d'évènements
+* @param[in] avertir: La fonction, appelée sur le fil de chargement registre verrouillé : elle doit être brève
+* et ne pas se servir du registre. nullptr pour ne plus être averti
+* @param[in] contexte: La valeur passée à la fonction
+*/
+void avertirChargements(void (*avertir)(void* contexte), void* contexte);
+/**
+* @brief Donne le dictionnaire d'un fichier de mots, chargé une seule fois par processus tant que le fichier ne change pas
+* @param[in] chemin: Le chemin du fichier de mots
+* @param[in] cheminBinaire: Le chemin du dictionnaire compilé par compilDico, essayé en premier
+* @return Le dictionnaire prêt, avec son arbre et sa table, vide si le fichier n'a pas pu être lu
+* @note Le dictionnaire est partagé : il ne doit pas être modifié, et doit être rendu par rendreDico
+* @see demanderDico, rendreDico
+*/
+Dico* prendreDico(const char* chemin, const char* cheminBinaire);
+/**
+* @brief Rend un dictionnaire pris au registre
+* @param[in] d: Le dictionnaire
+* @note Un dictionnaire qui n'est plus utilisé reste chargé pour les parties suivantes,
+* sauf si son fichier a changé depuis : il est alors libéré
+*/
+void rendreDico(const Dico* d);
+/**
+* @brief Libère les dictionnaires qu'aucune partie n'utilise, après avoir attendu les chargements en cours
+*/
+void viderRegistre();
+/**
+* @brief Donne les compteurs du registre
+* @return Les compteurs
+*/
+StatistiquesRegistre statistiquesRegistre();
+
+
+#endif // !_REGISTRE_
@@ -0,0 +1,452 @@
+/**
+ * @file serveur.cpp
+ * @brief Composant serveur : de nombreuses parties dans un seul processus, sur une socket locale
+ *
+ * Une partie qui lit cin bloque son processus tant que l'humain ne répond pas. Ici chaque partie avance
+ * par avancerPartie jusqu'à la prochaine saisie d'un humain, puis la session attend sa ligne sans fil
+ * d'exécution ni pile : une boucle epoll ne réveille que les sessions qui ont reçu quelque chose.
+ * Toutes les sessions lisent le même dictionnaire, pris au registre et chargé une seule fois.
+ * Une partie qui commence pendant le chargement attend qu'il finisse sans bloquer la boucle :
+ * le fil de chargement la réveille par un eventfd.
+ */
+
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "serveur.h"
+#include "registre.h"
+
+using namespace std;
+
+static volatile sig_atomic_t arret = 0; // Mis par SIGINT ou SIGTERM
+
+/**
+* @brief Demande l'arrêt du serveur
+* @param[in] signal: Le signal reçu
+*/
+static void demanderArret(int) {
+	arret = 1;
+}
+/**
+* @brief Réveille la boucle d'évènements quand un dictionnaire devient prêt, sur le fil de chargement
+* @param[in] contexte: Le descripteur de l'eventfd surveillé par la boucle
+*/
+static void reveillerBoucle(void* contexte) {
+	unsigned long long un = 1;
+	ssize_t n = write(*static_cast<int*>(contexte), &un, sizeof(un));
+	(void)n; // Le compteur déjà non nul réveille la boucle tout autant
+}
+
+/**
+* @brief Ajoute du texte à envoyer au client, en agrandissant le tampon d'envoi si besoin
+* @param[in,out] s: La sortie de la session
+* @param[in] texte: Les octets
+* @param[in] longueur: Le nombre d'octets
+*/
+static void ajouterSession(Sortie& s, const char* texte, unsigned int longueur) {
+	Session& se = *static_cast<Session*>(s.contexte);
+	if (se.tailleEnvoi + longueur > se.capaciteEnvoi) {
+		// Le texte déjà envoyé est oublié avant d'agrandir
+		unsigned int reste = se.tailleEnvoi - se.debutEnvoi;
+		unsigned int capacite = se.capaciteEnvoi == 0 ? (unsigned int)TAILLE_LIGNE_SESSION : se.capaciteEnvoi;
+		while (capacite < reste + longueur) capacite *= 2;
+		if (capacite > se.capaciteEnvoi) {
+			char* envoi = new char[capacite];
+			if (reste > 0) memcpy(envoi, se.envoi + se.debutEnvoi, reste);
+			delete[] se.envoi;
+			se.envoi = envoi;
+			se.capaciteEnvoi = capacite;
+		}
+		else {
+			memmove(se.envoi, se.envoi + se.debutEnvoi, reste);
+		}
+		se.debutEnvoi = 0;
+		se.tailleEnvoi = reste;
+	}
+	memcpy(se.envoi + se.tailleEnvoi, texte, longueur);
+	se.tailleEnvoi += longueur;
+}
+/**
+* @brief Termine la ligne en cours
+*/
+static void terminerLigneSession(Sortie& s) {
+	ajouterSession(s, "\n", 1);
+}
+/**
+* @brief Ne fait rien : la boucle envoie le texte après chaque évènement de la session
+*/
+static void viderSession(Sortie&) {
+}
+
+/**
+* @brief Ouvre la socket d'écoute, non bloquante
+* @param[in] adresse: Un chemin (contenant un '/') pour une socket Unix, sinon un port TCP sur 127.0.0.1
+* @return Le descripteur de la socket, -1 en cas d'erreur
+*/
+static int ouvrirEcoute(const char* adresse) {
+	int fd;
+	if (strchr(adresse, '/') != nullptr) {
+		sockaddr_un un;
+		if (strlen(adresse) >= sizeof(un.sun_path)) return -1;
+		memset(&un, 0, sizeof(un));
+		un.sun_family = AF_UNIX;
+		strcpy(un.sun_path, adresse);
+		fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (fd < 0) return -1;
+		unlink(adresse); // Laissée par un serveur précédent
+		if (bind(fd, (const sockaddr*)&un, sizeof(un)) < 0) {
+			close(fd);
+			return -1;
+		}
+	}
+	else {
+		int port = atoi(adresse);
+		if (port <= 0 || port > 65535) return -1;
+		sockaddr_in in;
+		memset(&in, 0, sizeof(in));
+		in.sin_family = AF_INET;
+		in.sin_port = htons((unsigned short)port);
+		in.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+		if (fd < 0) return -1;
+		int oui = 1;
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &oui, sizeof(oui));
+		if (bind(fd, (const sockaddr*)&in, sizeof(in)) < 0) {
+			close(fd);
+			return -1;
+		}
+	}
+	if (listen(fd, SOMAXCONN) < 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+/**
+* @brief Envoie au client ce qui peut l'être sans attendre, et surveille la socket en écriture s'il reste du texte
+* @param[in] ep: Le descripteur epoll
+* @param[in,out] se: La session
+*/
+static void envoyer(int ep, Session& se) {
+	while (se.debutEnvoi < se.tailleEnvoi) {
+		ssize_t n = send(se.fd, se.envoi + se.debutEnvoi, se.tailleEnvoi - se.debutEnvoi, MSG_NOSIGNAL);
+		if (n > 0) {
+			se.debutEnvoi += (unsigned int)n;
+		}
+		else if (n < 0 && errno == EINTR) {
+			continue;
+		}
+		else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			break;
+		}
+		else {
+			se.fermee = true; // Le client est parti
+			se.debutEnvoi = se.tailleEnvoi;
+		}
+	}
+	if (se.debutEnvoi == se.tailleEnvoi) {
+		se.debutEnvoi = 0;
+		se.tailleEnvoi = 0;
+	}
+
+	// Une socket dont le client a fini d'écrire resterait lisible : elle n'est plus surveillée qu'en écriture.
+	// Pendant l'attente du dictionnaire, ce que le client envoie reste dans la socket
+	unsigned int surveillance = (se.finLecture || se.attenteDico ? 0u : EPOLLIN | EPOLLRDHUP) | (se.tailleEnvoi > 0 ? EPOLLOUT : 0u);
+	if (surveillance != se.surveillance && !se.fermee) {
+		epoll_event ev;
+		ev.events = surveillance;
+		ev.data.ptr = &se;
+		epoll_ctl(ep, EPOLL_CTL_MOD, se.fd, &ev);
+		se.surveillance = surveillance;
+	}
+}
+/**
+* @brief Traite une ligne reçue d'un client : les joueurs de sa partie, puis ses saisies
+* @param[in] graine: La graine du serveur
+* @param[in,out] se: La session
+* @param[in,out] ligne: La ligne, sans son retour à la ligne, terminée par '\0'
+*/
+static void traiterLigne(unsigned long long graine, Session& se, char* ligne) {
+	if (se.enJeu) {
+		if (se.p.etat != PARTIE_FINIE) fournirSaisie(se.p, ligne);
+		return;
+	}
+
+	// Les joueurs sont le premier mot de la ligne
+	while (*ligne == ' ' || *ligne == '\t' || *ligne == '\r') ++ligne;
+	unsigned int longueur = 0;
+	while (ligne[longueur] != '\0' && ligne[longueur] != ' ' && ligne[longueur] != '\t' && ligne[longueur] != '\r') ++longueur;
+	ligne[longueur] = '\0';
+	if (longueur == 0) return;
+
+	const char* argv[] = { "singe", ligne, nullptr };
+	if (!verifNbJoueur(argv)) {
+		se.sortie << "Nombre de joueurs incorrect" << finLigne << "Joueurs > ";
+	}
+	else if (verifJoueur(argv) || strpbrk(ligne, "PpMm") != nullptr) {
+		// Résoudre le jeu ou chercher un coup Monte-Carlo bloquerait toutes les autres sessions
+		se.sortie << "Seuls les joueurs humains et robots jouent sur le serveur" << finLigne << "Joueurs > ";
+	}
+	else {
+		initialiserPartie(se.p, argv, graine + se.numero); // Le dictionnaire est repris au registre
+		se.p.sortie = &se.sortie;
+		se.enJeu = true;
+		// Un robot qui joue lit le dictionnaire : la partie ne commence que lorsqu'il est chargé
+		if (dicoPret(se.p.d)) avancerPartie(se.p);
+		else se.attenteDico = true;
+	}
+}
+/**
+* @brief Traite les octets reçus d'un client, ligne par ligne
+* @param[in] graine: La graine du serveur
+* @param[in,out] se: La session
+* @param[in] octets: Les octets reçus
+* @param[in] n: Le nombre d'octets
+* @return Le nombre d'octets traités : moins que n si la partie s'est mise à attendre le dictionnaire
+*/
+static unsigned int traiterOctets(unsigned long long graine, Session& se, const char* octets, unsigned int n) {
+	for (unsigned int i = 0; i < n; ++i) {
+		if (octets[i] == '\n') {
+			if (!se.ligneTropLongue) {
+				se.lecture[se.tailleLecture] = '\0';
+				traiterLigne(graine, se, se.lecture);
+			}
+			se.tailleLecture = 0;
+			se.ligneTropLongue = false;
+			if (se.attenteDico) return i + 1;
+		}
+		else if (se.tailleLecture < TAILLE_LIGNE_SESSION - 1) {
+			se.lecture[se.tailleLecture++] = octets[i];
+		}
+		else {
+			se.ligneTropLongue = true;
+		}
+	}
+	return n;
+}
+/**
+* @brief Lit tout ce que le client a envoyé et traite chaque ligne complète
+* @param[in] graine: La graine du serveur
+* @param[in,out] se: La session
+*/
+static void lire(unsigned long long graine, Session& se) {
+	char bloc[4096];
+	for (;;) {
+		ssize_t n = read(se.fd, bloc, sizeof(bloc));
+		if (n < 0 && errno == EINTR) continue;
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+		if (n == 0) {
+			se.finLecture = true; // Ce qui reste à envoyer l'est encore
+			return;
+		}
+		if (n < 0) {
+			se.fermee = true;
+			return;
+		}
+		unsigned int traites = traiterOctets(graine, se, bloc, (unsigned int)n);
+		if (se.attenteDico) {
+			// La suite du bloc sera traitée quand la partie aura commencé
+			se.tailleReste = (unsigned int)n - traites;
+			if (se.tailleReste > 0) {
+				se.reste = new char[se.tailleReste];
+				memcpy(se.reste, bloc + traites, se.tailleReste);
+			}
+			return;
+		}
+	}
+}
+/**
+* @brief Ferme une session et libère sa partie
+* @param[in,out] se: La session, détruite
+* @param[in,out] sessions: La première des sessions ouvertes
+*/
+static void fermer(Session* se, Session*& sessions) {
+	close(se->fd); // La retire aussi d'epoll
+	if (se->precedente != nullptr) se->precedente->suivante = se->suivante;
+	else sessions = se->suivante;
+	if (se->suivante != nullptr) se->suivante->precedente = se->precedente;
+	if (se->enJeu) detruirePartie(se->p);
+	delete[] se->envoi;
+	delete[] se->reste;
+	delete se;
+}
+/**
+* @brief Indique si une session est à fermer : erreur, client parti ou partie finie dont la fin est envoyée
+* @param[in] se: La session
+* @return true si la session est à fermer, false sinon
+*/
+static bool estTerminee(const Session& se) {
+	return se.fermee || (!se.attenteDico && se.tailleEnvoi == 0 && (se.finLecture || (se.enJeu && se.p.etat == PARTIE_FINIE)));
+}
+/**
+* @brief Commence les parties qui attendaient le dictionnaire, s'il est prêt, et traite ce que leur client a envoyé entre-temps
+* @param[in] ep: Le descripteur epoll
+* @param[in] graine: La graine du serveur
+* @param[in,out] sessions: La première des sessions ouvertes
+*/
+static void commencerParties(int ep, unsigned long long graine, Session*& sessions) {
+	Session* suivante;
+	for (Session* se = sessions; se != nullptr; se = suivante) {
+		suivante = se->suivante; // se peut être fermée
+		if (!se->attenteDico || !dicoPret(se->p.d)) continue;
+		se->attenteDico = false;
+		avancerPartie(se->p);
+		if (se->reste != nullptr) {
+			traiterOctets(graine, *se, se->reste, se->tailleReste);
+			delete[] se->reste;
+			se->reste = nullptr;
+			se->tailleReste = 0;
+		}
+		envoyer(ep, *se); // La socket est de nouveau lue
+		if (estTerminee(*se)) fermer(se, sessions);
+	}
+}
+/**
+* @brief Accepte toutes les connexions en attente et leur demande les joueurs
+* @param[in] ep: Le descripteur epoll
+* @param[in] ecoute: La socket d'écoute
+* @param[in,out] sessions: La première des sessions ouvertes
+* @param[in,out] nbConnexions: Le nombre de connexions acceptées depuis le démarrage
+*/
+static void accepter(int ep, int ecoute, Session*& sessions, unsigned long long& nbConnexions) {
+	for (;;) {
+		int fd = accept4(ecoute, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno == EINTR || errno == ECONNABORTED) continue;
+			return; // Plus de connexion en attente, ou plus de descripteur libre
+		}
+
+		Session* se = new Session;
+		se->fd = fd;
+		se->numero = nbConnexions++;
+		se->enJeu = false;
+		se->fermee = false;
+		se->finLecture = false;
+		se->attenteDico = false;
+		se->surveillance = EPOLLIN | EPOLLRDHUP;
+		initialiserSortieNulle(se->sortie);
+		se->sortie.ajouter = ajouterSession;
+		se->sortie.terminerLigne = terminerLigneSession;
+		se->sortie.vider = viderSession;
+		se->sortie.contexte = se;
+		se->envoi = nullptr;
+		se->debutEnvoi = 0;
+		se->tailleEnvoi = 0;
+		se->capaciteEnvoi = 0;
+		se->tailleLecture = 0;
+		se->ligneTropLongue = false;
+		se->reste = nullptr;
+		se->tailleReste = 0;
+		se->precedente = nullptr;
+		se->suivante = sessions;
+		if (sessions != nullptr) sessions->precedente = se;
+		sessions = se;
+
+		epoll_event ev;
+		ev.events = se->surveillance;
+		ev.data.ptr = se;
+		if (epoll_ctl(ep, EPOLL_CTL_ADD, fd, &ev) < 0) {
+			fermer(se, sessions);
+			continue;
+		}
+		se->sortie << "Joueurs > ";
+		envoyer(ep, *se);
+	}
+}
+/**
+* @brief Sert des parties à des clients, jusqu'à un signal SIGINT ou SIGTERM
+* @param[in] adresse: Un chemin (contenant un '/') pour une socket Unix, sinon un port TCP sur 127.0.0.1
+* @param[in] graine: La graine des tirages des robots, la session n en utilise graine + n
+* @return 0 si le serveur s'est arrêté normalement, 1 si la socket n'a pas pu être ouverte
+* @note Un client envoie d'abord les joueurs de sa partie, par exemple HR, puis une saisie par ligne.
+* Les humains attendent leur saisie sans rien coûter d'autre que leur session, les robots jouent aussitôt.
+* Toutes les sessions prennent le même dictionnaire au registre, qui ne le recharge que si son fichier change.
+* @see avancerPartie, fournirSaisie, prendreDico
+*/
+int servir(const char* adresse, unsigned long long graine) {
+	// Une session par descripteur : autant de sessions que le système le permet
+	rlimit limite;
+	if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+		limite.rlim_cur = limite.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limite);
+	}
+
+	int ecoute = ouvrirEcoute(adresse);
+	if (ecoute < 0) {
+		cout << "Impossible d'écouter sur " << adresse << endl;
+		return 1;
+	}
+	int ep = epoll_create1(EPOLL_CLOEXEC);
+	epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.ptr = nullptr; // La socket d'écoute
+	epoll_ctl(ep, EPOLL_CTL_ADD, ecoute, &ev);
+	int reveil = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); // Écrit par le registre quand un dictionnaire est prêt
+	ev.events = EPOLLIN;
+	ev.data.ptr = &reveil;
+	epoll_ctl(ep, EPOLL_CTL_ADD, reveil, &ev);
+	avertirChargements(reveillerBoucle, &reveil);
+
+	arret = 0;
+	signal(SIGINT, demanderArret);
+	signal(SIGTERM, demanderArret);
+	cout << "Serveur à l'écoute sur " << adresse << endl;
+
+	Session* sessions = nullptr;
+	unsigned long long nbConnexions = 0;
+	epoll_event evenements[NB_EVENEMENTS];
+	while (!arret) {
+		int n = epoll_wait(ep, evenements, NB_EVENEMENTS, -1);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			break;
+		}
+		for (int i = 0; i < n; ++i) {
+			if (evenements[i].data.ptr == nullptr) {
+				accepter(ep, ecoute, sessions, nbConnexions);
+				continue;
+			}
+			if (evenements[i].data.ptr == &reveil) {
+				unsigned long long compteur;
+				ssize_t lu = read(reveil, &compteur, sizeof(compteur));
+				(void)lu;
+				commencerParties(ep, graine, sessions);
+				continue;
+			}
+
+			Session& se = *static_cast<Session*>(evenements[i].data.ptr);
+			if (evenements[i].events & EPOLLIN) lire(graine, se);
+			if (evenements[i].events & EPOLLERR) se.fermee = true;
+			envoyer(ep, se);
+
+			// Une partie finie est fermée dès que sa fin est envoyée
+			if (estTerminee(se)) {
+				fermer(&se, sessions);
+			}
+		}
+	}
+
+	avertirChargements(nullptr, nullptr);
+	while (sessions != nullptr) fermer(sessions, sessions);
+	close(reveil);
+	close(ep);
+	close(ecoute);
+	if (strchr(adresse, '/') != nullptr) unlink(adresse);
+	StatistiquesRegistre registre = statistiquesRegistre();
+	cout << nbConnexions << " connexions servies, dictionnaire chargé " << registre.nbChargements
+		<< " fois et repris " << registre.nbReutilisations << " fois" << endl;
+	return 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#ifndef _SERVEUR_
+#define _SERVEUR_
+
+/**
+ * @file serveur.h
+ * @brief Entête du composant serveur : de nombreuses parties dans un seul processus, sur une socket locale
+ */
+
+#include "fonctions.h"
+
+ /**
+ * @brief Les constantes du serveur
+ */
+enum {
+	TAILLE_LIGNE_SESSION = 256, // Ligne la plus longue lue d'un client, la suite est ignorée
+	NB_EVENEMENTS = 64, // Évènements traités par appel à epoll_wait
+};
+
+/**
+* @brief Une connexion au serveur et la partie qui s'y joue
+*/
+struct Session {
+	int fd;
+	unsigned long long numero; // Rang de la connexion, ajouté à la graine du serveur
+	bool enJeu; // Faux tant que le client n'a pas donné les joueurs
+	bool fermee; // La connexion est perdue, la session doit être fermée
+	bool finLecture; // Le client n'enverra plus rien : la session est fermée dès que tout est envoyé
+	bool attenteDico; // La partie attend que le dictionnaire soit chargé pour commencer : la socket n'est plus lue
+	unsigned int surveillance; // Évènements surveillés par epoll pour la session
+	Partie p;
+	Sortie sortie; // Écrit dans envoi
+	char* envoi; // Texte à envoyer, nullptr tant que rien n'a été écrit
+	unsigned int debutEnvoi; // Premier octet pas encore envoyé
+	unsigned int tailleEnvoi;
+	unsigned int capaciteEnvoi;
+	char lecture[TAILLE_LIGNE_SESSION]; // Début de la ligne en cours de lecture
+	unsigned int tailleLecture;
+	bool ligneTropLongue; // La fin de la ligne en cours est ignorée
+	char* reste; // Octets reçus après les joueurs pendant l'attente du dictionnaire, nullptr s'il n'y en a pas
+	unsigned int tailleReste;
+	Session* precedente; // Sessions ouvertes, pour les fermer à l'arrêt
+	Session* suivante;
+};
+
+/**
+* @brief Sert des parties à des clients, jusqu'à un signal SIGINT ou SIGTERM
+* @param[in] adresse: Un chemin (contenant un '/') pour une socket Unix, sinon un port TCP sur 127.0.0.1
+* @param[in] graine: La graine des tirages des robots, la session n en utilise graine + n
+* @return 0 si le serveur s'est arrêté normalement, 1 si la socket n'a pas pu être ouverte
+* @note Un client envoie d'abord les joueurs de sa partie, par exemple HR, puis une saisie par ligne.
+* Les humains attendent leur saisie sans rien coûter d'autre que leur session, les robots jouent aussitôt.
+* Toutes les sessions prennent le même dictionnaire au registre, qui ne le recharge que si son fichier change.
+* @see avancerPartie, fournirSaisie, prendreDico
+*/
+int servir(const char* adresse, unsigned long long graine);
+
+
+#endif // !_SERVEUR_
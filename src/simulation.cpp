@@ -0,0 +1,154 @@
+/**
+ * @file simulation.cpp
+ * @brief Composant de simulation de parties entre robots, sans affichage
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+
+#include "simulation.h"
+
+using namespace std;
+
+enum {
+	PARTIES_PAR_LOT = 256, // Parties qu'un fil d'exécution du tournoi prend à la fois
+};
+
+/**
+* @brief Initialise un bilan vide
+* @param[out] b: Le bilan
+* @param[in] nbJoueurs: Le nombre de joueurs des parties
+* @see detruireBilan
+*/
+void initialiserBilan(Bilan& b, unsigned int nbJoueurs) {
+	b.nbJoueurs = nbJoueurs;
+	b.nbParties = 0;
+	b.nbManches = 0;
+	b.defaites = new unsigned long long[nbJoueurs];
+	b.quarts = new unsigned long long[nbJoueurs];
+	for (unsigned int i = 0; i < nbJoueurs; ++i) {
+		b.defaites[i] = 0;
+		b.quarts[i] = 0;
+	}
+	b.secondes = 0;
+}
+/**
+* @brief Joue des parties à la suite sans rien afficher et cumule leurs résultats
+* @param[in,out] p: La partie initialisée, qui ne doit compter que des robots
+* @param[in] nbParties: Le nombre de parties à jouer
+* @param[in,out] b: Le bilan où cumuler les résultats
+* @see recommencerPartie
+*/
+void simulerParties(Partie& p, unsigned long long nbParties, Bilan& b) {
+	Sortie sortieNulle;
+	initialiserSortieNulle(sortieNulle);
+	Sortie* sortie = p.sortie;
+	p.sortie = &sortieNulle;
+
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+	for (unsigned long long n = 0; n < nbParties; ++n) {
+		recommencerPartie(p);
+		jouerPartie(p);
+
+		for (unsigned int i = 0; i < p.nbJoueurs; ++i) {
+			b.quarts[i] += p.joueurs[i].score;
+			b.nbManches += p.joueurs[i].score;
+			if (p.joueurs[i].score == 4) ++b.defaites[i];
+		}
+		++b.nbParties;
+	}
+	b.secondes += chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+	p.sortie = sortie;
+}
+/**
+* @brief Joue des parties indépendantes en parallèle, toutes sur le dictionnaire d'une même partie
+* @param[in] modele: La partie initialisée, qui ne doit compter que des robots, dont la graine fixe le bilan
+* @param[in] nbParties: Le nombre de parties à jouer
+* @param[in] nbThreads: Le nombre de fils d'exécution à utiliser, 0 pour un par coeur
+* @param[in,out] b: Le bilan où cumuler les résultats
+* @see initialiserPartieCopie, simulerParties
+*/
+void simulerTournoi(const Partie& modele, unsigned long long nbParties, unsigned int nbThreads, Bilan& b) {
+	if (nbThreads == 0) nbThreads = thread::hardware_concurrency();
+	if (nbThreads == 0) nbThreads = 1;
+
+	// Chaque fil a sa partie et son bilan : rien n'est partagé en écriture pendant le tournoi
+	Partie* parties = new Partie[nbThreads];
+	Bilan* bilans = new Bilan[nbThreads];
+	for (unsigned int t = 0; t < nbThreads; ++t) {
+		initialiserPartieCopie(parties[t], modele);
+		attendreDicoPartie(parties[t]); // Le chargement du dictionnaire n'est pas compté dans la durée du tournoi
+		initialiserBilan(bilans[t], modele.nbJoueurs);
+	}
+
+	chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+	atomic<unsigned long long> prochaine(0);
+	thread* fils = new thread[nbThreads];
+	for (unsigned int t = 0; t < nbThreads; ++t) {
+		fils[t] = thread([&, t]() {
+			unsigned long long premiere;
+			while ((premiere = prochaine.fetch_add(PARTIES_PAR_LOT)) < nbParties) {
+				unsigned long long lot = nbParties - premiere;
+				if (lot > PARTIES_PAR_LOT) lot = PARTIES_PAR_LOT;
+				// Les tirages d'un lot ne dépendent que de la graine et du numéro du lot, pas du fil qui le joue :
+				// le bilan est le même quel que soit le nombre de fils
+				initialiserGenerateur(parties[t].hasard, modele.graine + premiere / PARTIES_PAR_LOT);
+				simulerParties(parties[t], lot, bilans[t]);
+			}
+		});
+	}
+	for (unsigned int t = 0; t < nbThreads; ++t) {
+		fils[t].join();
+	}
+	b.secondes += chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+	delete[] fils;
+
+	for (unsigned int t = 0; t < nbThreads; ++t) {
+		cumulerBilan(b, bilans[t]);
+		detruireBilan(bilans[t]);
+		detruirePartie(parties[t]);
+	}
+	delete[] bilans;
+	delete[] parties;
+}
+/**
+* @brief Ajoute les résultats d'un bilan à un autre, sans sa durée
+* @param[in,out] b: Le bilan où cumuler
+* @param[in] autre: Le bilan à ajouter, pour le même nombre de joueurs
+*/
+void cumulerBilan(Bilan& b, const Bilan& autre) {
+	b.nbParties += autre.nbParties;
+	b.nbManches += autre.nbManches;
+	for (unsigned int i = 0; i < b.nbJoueurs && i < autre.nbJoueurs; ++i) {
+		b.defaites[i] += autre.defaites[i];
+		b.quarts[i] += autre.quarts[i];
+	}
+}
+/**
+* @brief Affiche les résultats cumulés et le nombre de parties jouées par seconde
+* @param[in] b: Le bilan
+* @param[in] p: La partie simulée, pour le type des joueurs
+* @param[in,out] os: Où afficher
+*/
+void afficherBilan(const Bilan& b, const Partie& p, ostream& os) {
+	os << "parties " << b.nbParties << ", manches " << b.nbManches << ", " << fixed << setprecision(3) << b.secondes << " s, "
+		<< setprecision(0) << (b.secondes > 0 ? b.nbParties / b.secondes : 0) << " parties/s" << endl;
+	for (unsigned int i = 0; i < b.nbJoueurs; ++i) {
+		os << i + 1 << p.joueurs[i].type << " : " << b.defaites[i] << " parties perdues, "
+			<< b.quarts[i] << " quarts de singe" << endl;
+	}
+}
+/**
+* @brief Libère la mémoire d'un bilan
+* @param[in,out] b: Le bilan à détruire
+*/
+void detruireBilan(Bilan& b) {
+	delete[] b.defaites;
+	b.defaites = nullptr;
+	delete[] b.quarts;
+	b.quarts = nullptr;
+}
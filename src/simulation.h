@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef _SIMULATION_
+#define _SIMULATION_
+
+/**
+ * @file simulation.h
+ * @brief Entête du composant de simulation de parties entre robots, sans affichage
+ */
+
+#include <iosfwd>
+
+#include "fonctions.h"
+
+/**
+* @brief Résultats cumulés d'une série de parties
+*/
+struct Bilan {
+	unsigned int nbJoueurs;
+	unsigned long long nbParties;
+	unsigned long long nbManches;
+	unsigned long long* defaites; // Parties perdues (quatre quarts de singe) par chaque joueur
+	unsigned long long* quarts; // Quarts de singe pris par chaque joueur
+	double secondes; // Durée de la simulation
+};
+
+/**
+* @brief Initialise un bilan vide
+* @param[out] b: Le bilan
+* @param[in] nbJoueurs: Le nombre de joueurs des parties
+* @see detruireBilan
+*/
+void initialiserBilan(Bilan& b, unsigned int nbJoueurs);
+/**
+* @brief Joue des parties à la suite sans rien afficher et cumule leurs résultats
+* @param[in,out] p: La partie initialisée, qui ne doit compter que des robots
+* @param[in] nbParties: Le nombre de parties à jouer
+* @param[in,out] b: Le bilan où cumuler les résultats
+* @see recommencerPartie
+*/
+void simulerParties(Partie& p, unsigned long long nbParties, Bilan& b);
+/**
+* @brief Joue des parties indépendantes en parallèle, toutes sur le dictionnaire d'une même partie
+* @param[in] modele: La partie initialisée, qui ne doit compter que des robots, dont la graine fixe le bilan
+* @param[in] nbParties: Le nombre de parties à jouer
+* @param[in] nbThreads: Le nombre de fils d'exécution à utiliser, 0 pour un par coeur
+* @param[in,out] b: Le bilan où cumuler les résultats
+* @see initialiserPartieCopie, simulerParties
+*/
+void simulerTournoi(const Partie& modele, unsigned long long nbParties, unsigned int nbThreads, Bilan& b);
+/**
+* @brief Ajoute les résultats d'un bilan à un autre, sans sa durée
+* @param[in,out] b: Le bilan où cumuler
+* @param[in] autre: Le bilan à ajouter, pour le même nombre de joueurs
+*/
+void cumulerBilan(Bilan& b, const Bilan& autre);
+/**
+* @brief Affiche les résultats cumulés et le nombre de parties jouées par seconde
+* @param[in] b: Le bilan
+* @param[in] p: La partie simulée, pour le type des joueurs
+* @param[in,out] os: Où afficher
+*/
+void afficherBilan(const Bilan& b, const Partie& p, std::ostream& os);
+/**
+* @brief Libère la mémoire d'un bilan
+* @param[in,out] b: Le bilan à détruire
+*/
+void detruireBilan(Bilan& b);
+
+
+#endif // !_SIMULATION_
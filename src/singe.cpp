@@ -1,38 +1,179 @@
 /**
  * @file singe.cpp
- * Projet SAE102 - Comparaison dapproches algorithmiques
+ * Projet SAE102 - Comparaison dapproches algorithmiques
  * @author Namodacane KALIAMOORTHY et Alexandre CAROUNANITHI
  * @version 15 - 02/01/2023
  * @brief Programme principal du jeu : Le Quart du Singe
+ *
+ * Compilation : g++ -O2 -std=c++17 -pthread dico.cpp table.cpp solveur.cpp hasard.cpp sortie.cpp registre.cpp \
+ *               statistiques.cpp montecarlo.cpp livre.cpp fonctions.cpp simulation.cpp serveur.cpp singe.cpp -o singe
+ * Utilisation : singe JOUEURS (une lettre par joueur : H humain, R robot, P robot parfait,
+ *               M robot Monte-Carlo, dont les coups dépendent du temps et ne sont pas rejoués par --seed,
+ *               et dont les deux premières lettres de chaque manche sont lues dans ./ods4.livre s'il existe)
+ *               singe --simulate N [--threads T] JOUEURS (N parties entre robots, sans affichage,
+ *               réparties sur T fils d'exécution qui partagent le dictionnaire, un par coeur par défaut)
+ *               --seed S avant les joueurs rejoue les mêmes tirages des robots
+ *               --json avant les joueurs écrit la partie en lignes JSON
+ *               singe --serve ADRESSE (parties des clients d'une socket Unix, si ADRESSE est un chemin,
+ *               ou TCP sur 127.0.0.1 si c'est un port, toutes dans ce processus)
+ *               --stats avant les joueurs affiche à la fin les compteurs et les durées des chemins chauds
+ *               --seuil US avant les joueurs fait compter par --stats les coups de robot plus longs que US microsecondes
+ *               --reflexion US avant les joueurs donne le temps de chaque coup du robot Monte-Carlo 'M', en microsecondes
  */
 
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include <locale>
+#include <new>
 
 #include "fonctions.h"
+#include "simulation.h"
+#include "serveur.h"
+#include "registre.h"
+#include "statistiques.h"
+#include "montecarlo.h"
+#include "livre.h"
+
+#if STATISTIQUES
+// Les allocations sont comptées par fil d'exécution, pour le nombre d'allocations par partie de --stats
+void* operator new(size_t taille) {
+	compterAllocation();
+	void* bloc = malloc(taille > 0 ? taille : 1);
+	if (bloc == nullptr) throw std::bad_alloc();
+	return bloc;
+}
+void* operator new[](size_t taille) {
+	return operator new(taille);
+}
+void operator delete(void* p) noexcept {
+	free(p);
+}
+void operator delete[](void* p) noexcept {
+	free(p);
+}
+void operator delete(void* p, size_t) noexcept {
+	free(p);
+}
+void operator delete[](void* p, size_t) noexcept {
+	free(p);
+}
+#endif
 
 int main(int argc, const char* argv[]) {
 
 	setlocale(LC_CTYPE, "fra");
-	srand(time(NULL));
 	
 	Partie p;
 
+	// Les options précèdent les joueurs, chacune suivie de sa valeur sauf --json et --stats
+	bool json = false;
+	bool stats = false;
+	unsigned long long nbParties = 0;
+	unsigned int nbThreads = 0; // Un par coeur
+	unsigned long long graine = (unsigned long long)time(NULL);
+	const char* adresse = nullptr;
+	unsigned long long seuil = 0; // En ns, sans seuil par défaut
+	unsigned long long reflexion = 0; // En ns, REFLEXION_MONTE_CARLO par défaut
+	while (argc > 1 && strncmp(argv[1], "--", 2) == 0) {
+		if (argc > 2 && strcmp(argv[1], "--simulate") == 0 && atoll(argv[2]) > 0) {
+			nbParties = (unsigned long long)atoll(argv[2]);
+		}
+		else if (argc > 2 && strcmp(argv[1], "--threads") == 0 && atoi(argv[2]) > 0) {
+			nbThreads = (unsigned int)atoi(argv[2]);
+		}
+		else if (argc > 2 && strcmp(argv[1], "--seed") == 0) {
+			graine = strtoull(argv[2], nullptr, 10);
+		}
+		else if (argc > 2 && strcmp(argv[1], "--seuil") == 0 && atoll(argv[2]) > 0) {
+			seuil = (unsigned long long)atoll(argv[2]) * 1000;
+		}
+		else if (argc > 2 && strcmp(argv[1], "--reflexion") == 0 && atoll(argv[2]) > 0) {
+			reflexion = (unsigned long long)atoll(argv[2]) * 1000;
+		}
+		else if (argc > 2 && strcmp(argv[1], "--serve") == 0) {
+			adresse = argv[2];
+		}
+		else if (strcmp(argv[1], "--json") == 0) {
+			json = true;
+			argv += 1;
+			argc -= 1;
+			continue;
+		}
+		else if (strcmp(argv[1], "--stats") == 0) {
+			stats = true;
+			statistiquesActives = true;
+			argv += 1;
+			argc -= 1;
+			continue;
+		}
+		else {
+			std::cout << "Utilisation : singe [--simulate N] [--threads T] [--seed S] [--json] [--stats] [--seuil US] [--reflexion US] JOUEURS" << std::endl;
+			std::cout << "              singe [--seed S] [--stats] --serve ADRESSE" << std::endl;
+			return 2;
+		}
+		argv += 2;
+		argc -= 2;
+	}
+
+	if (adresse != nullptr) {
+		// Le dictionnaire est chargé avant la première connexion, puis chaque session le reprend au registre
+		const char* modele[] = { argv[0], "RR", nullptr };
+		initialiserPartie(p, modele, graine);
+		int code = servir(adresse, graine);
+		detruirePartie(p);
+		viderRegistre();
+		if (stats) afficherStatistiques(std::cout);
+		return code;
+	}
+
 	if (!verifNbJoueur(argv)) {
-		std::cout << "Nombre insuffisant de joueurs" << std::endl;
+		std::cout << "Nombre de joueurs incorrect" << std::endl;
 		return 2;
 	}
 	else {
 		if (verifJoueur(argv)) {
-			std::cout << "Seul les joueurs humains et robots sont accepts" << std::endl;
+			std::cout << "Seul les joueurs humains et robots sont acceptés" << std::endl;
+			return 2;
+		}
+		if (nbParties > 0 && (strchr(argv[1], 'H') != nullptr || strchr(argv[1], 'h') != nullptr)) {
+			std::cout << "Seuls des robots peuvent jouer en simulation" << std::endl;
 			return 2;
 		}
+		// Le livre d'ouvertures est projeté une fois les joueurs validés, s'il a été calculé par livreOuvertures
+		Livre livre;
+		ouvrirLivre(livre, "./ods4.livre");
+		if (nbParties > 0) {
+			initialiserPartie(p, argv, graine);
+			p.seuilCoup = seuil; // Repris par les parties de chaque fil
+			p.reflexionCoup = reflexion;
+			p.livre = (livre.projection != nullptr) ? &livre : nullptr;
+			Bilan b;
+			initialiserBilan(b, p.nbJoueurs);
+			simulerTournoi(p, nbParties, nbThreads, b);
+			afficherBilan(b, p, std::cout);
+			detruireBilan(b);
+			detruirePartie(p);
+		}
 		else {
-			initialiserPartie(p, argv);
+			initialiserPartie(p, argv, graine);
+			p.seuilCoup = seuil;
+			p.reflexionCoup = reflexion;
+			p.livre = (livre.projection != nullptr) ? &livre : nullptr;
+			// Seule partie du processus, le robot Monte-Carlo cherche ses coups sur tous les coeurs
+			if (strchr(argv[1], 'M') != nullptr || strchr(argv[1], 'm') != nullptr) p.pool = demarrerPoolMonteCarlo(0);
+			static SortieFlot sortieJson;
+			if (json) {
+				initialiserSortieJson(sortieJson, std::cout);
+				p.sortie = &sortieJson.sortie;
+			}
 			jouerPartie(p);
+			arreterPoolMonteCarlo(p.pool);
 			detruirePartie(p);
 		}
+		viderRegistre(); // Attend un chargement encore en cours avant de libérer le dictionnaire
+		fermerLivre(livre);
+		if (stats) afficherStatistiques(std::cout);
 	}		
 	
 	return 0;
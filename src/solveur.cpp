@@ -0,0 +1,169 @@
+/**
+ * @file solveur.cpp
+ * @brief Composant de résolution du jeu sur l'arbre des préfixes
+ *
+ * Règles prises en compte (celles de verification) : le joueur qui forme un mot de plus de deux lettres
+ * prend un quart de singe, et celui dont le préfixe ne commence aucun mot le prend s'il est contesté
+ * par un '?'. Contester un préfixe qui commence un mot fait perdre celui qui conteste, sauf après une
+ * ou deux lettres : le joueur précédent perd alors toujours. Un '?' avant toute lettre fait perdre celui qui le tape.
+ */
+
+#include <cstring>
+#include <climits>
+#include <thread>
+#include <atomic>
+
+#include "solveur.h"
+
+using namespace std;
+
+/**
+* @brief Donne le perdant d'un '?' tapé après le préfixe d'un noeud, comme le décide verification
+* @param[in] s: La solution
+* @param[in] profondeur: La longueur du préfixe du noeud
+* @return Le joueur qui prend le quart de singe, compté à partir de celui qui conteste (0 = lui)
+* @note Le préfixe d'un noeud commence toujours un mot : le joueur précédent en a un à donner
+*/
+static unsigned char perdantInterrogation(const Solution& s, unsigned int profondeur) {
+	if (profondeur == 0) return 0; // Aucun mot n'a été saisi
+	if (profondeur <= 2) return (unsigned char)(s.nbJoueurs - 1); // Contester une ou deux lettres fait perdre le précédent
+	return 0;
+}
+/**
+* @brief Détermine le coup et le perdant d'un noeud dont les fils sont déjà résolus
+* @param[in,out] s: La solution
+* @param[in] d: Le dictionnaire
+* @param[in] noeud: Le noeud
+* @param[in] profondeur: La longueur du préfixe du noeud
+*/
+static void evaluerNoeud(Solution& s, const Dico& d, unsigned int noeud, unsigned int profondeur) {
+	const Noeud& n = d.noeuds[noeud];
+	char coup = '\0';
+	unsigned char perdant = 0;
+	unsigned int plusDeMots = 0;
+
+	// Le '?' est un coup comme les lettres, il reste le seul quand aucune lettre ne continue le préfixe.
+	// S'il fait perdre un autre joueur, la manche finit aussitôt : il passe avant les lettres
+	unsigned char interrogation = perdantInterrogation(s, profondeur);
+	if (interrogation != 0) {
+		s.coups[noeud] = '?';
+		s.perdants[noeud] = interrogation;
+		return;
+	}
+
+	for (unsigned int i = n.premierFils; i < n.premierFils + n.nbFils; ++i) {
+		const Noeud& fils = d.noeuds[i];
+		// Former un mot de plus de deux lettres fait perdre, sinon c'est au joueur suivant
+		unsigned char resultat = 0;
+		if (!fils.estMot || profondeur + 1 <= 2) {
+			resultat = (unsigned char)((1 + s.perdants[i]) % s.nbJoueurs);
+		}
+		if (resultat != 0) {
+			// La première lettre, par ordre alphabétique, qui fait perdre un autre joueur
+			coup = fils.lettre;
+			perdant = resultat;
+			break;
+		}
+		// Perdu quoi qu'il arrive : on garde la lettre qui laisse le plus de mots aux autres
+		if (coup == '\0' || fils.nbMots > plusDeMots) {
+			coup = fils.lettre;
+			plusDeMots = fils.nbMots;
+		}
+	}
+	if (coup == '\0') coup = '?'; // Aucune lettre : contester le précédent, et perdre
+	s.coups[noeud] = coup;
+	s.perdants[noeud] = perdant;
+}
+/**
+* @brief Résout un noeud et tous ses descendants, des feuilles vers la racine
+* @param[in,out] s: La solution
+* @param[in] d: Le dictionnaire
+* @param[in] noeud: Le noeud
+* @param[in] profondeur: La longueur du préfixe du noeud
+*/
+static void resoudreSousArbre(Solution& s, const Dico& d, unsigned int noeud, unsigned int profondeur) {
+	const Noeud& n = d.noeuds[noeud];
+	for (unsigned int i = n.premierFils; i < n.premierFils + n.nbFils; ++i) {
+		// Sous un mot de plus de deux lettres la manche est finie, inutile d'aller plus loin
+		if (!d.noeuds[i].estMot || profondeur + 1 <= 2) {
+			resoudreSousArbre(s, d, i, profondeur + 1);
+		}
+	}
+	evaluerNoeud(s, d, noeud, profondeur);
+}
+/**
+* @brief Résout le jeu : pour chaque préfixe, qui perd la manche et quelle lettre jouer
+* @param[out] s: La solution
+* @param[in] d: Le dictionnaire, dont l'arbre est construit
+* @param[in] nbJoueurs: Le nombre de joueurs de la partie, au plus UCHAR_MAX (rien n'est résolu au-delà)
+* @param[in] nbThreads: Le nombre de fils d'exécution à utiliser, 0 pour un par coeur
+* @see detruireSolution
+*/
+void resoudre(Solution& s, const Dico& d, unsigned int nbJoueurs, unsigned int nbThreads) {
+	s.nbJoueurs = nbJoueurs;
+	s.nbNoeuds = d.nbNoeuds;
+	s.coups = new char[d.nbNoeuds];
+	s.perdants = new unsigned char[d.nbNoeuds];
+	memset(s.coups, 0, d.nbNoeuds);
+	memset(s.perdants, 0, d.nbNoeuds);
+	if (d.nbNoeuds == 0 || nbJoueurs == 0 || nbJoueurs > UCHAR_MAX) return; // Un joueur tient dans un octet de perdants
+
+	// Les sous-arbres des préfixes de deux lettres sont indépendants : ils sont répartis entre les fils d'exécution
+	const Noeud& racine = d.noeuds[0];
+	unsigned int nbTaches = 0;
+	for (unsigned int i = racine.premierFils; i < racine.premierFils + racine.nbFils; ++i) {
+		nbTaches += d.noeuds[i].nbFils;
+	}
+	unsigned int* taches = new unsigned int[nbTaches];
+	nbTaches = 0;
+	for (unsigned int i = racine.premierFils; i < racine.premierFils + racine.nbFils; ++i) {
+		for (unsigned int j = d.noeuds[i].premierFils; j < d.noeuds[i].premierFils + d.noeuds[i].nbFils; ++j) {
+			taches[nbTaches++] = j;
+		}
+	}
+
+	if (nbThreads == 0) nbThreads = thread::hardware_concurrency();
+	if (nbThreads == 0) nbThreads = 1;
+	atomic<unsigned int> prochaine(0);
+	thread* fils = new thread[nbThreads];
+	for (unsigned int t = 0; t < nbThreads; ++t) {
+		fils[t] = thread([&]() {
+			unsigned int i;
+			while ((i = prochaine.fetch_add(1)) < nbTaches) {
+				resoudreSousArbre(s, d, taches[i], 2);
+			}
+		});
+	}
+	for (unsigned int t = 0; t < nbThreads; ++t) {
+		fils[t].join();
+	}
+	delete[] fils;
+	delete[] taches;
+
+	// Il reste les préfixes d'une lettre et le préfixe vide
+	for (unsigned int i = racine.premierFils; i < racine.premierFils + racine.nbFils; ++i) {
+		evaluerNoeud(s, d, i, 1);
+	}
+	evaluerNoeud(s, d, 0, 0);
+}
+/**
+* @brief Donne le coup à jouer après un préfixe
+* @param[in] s: La solution
+* @param[in] noeud: Le noeud du préfixe dans l'arbre
+* @return La lettre ou '?', '\0' si le préfixe n'est pas résolu
+*/
+char coupSolution(const Solution& s, unsigned int noeud) {
+	if (noeud >= s.nbNoeuds) return '\0';
+	return s.coups[noeud];
+}
+/**
+* @brief Libère la mémoire d'une solution
+* @param[in,out] s: La solution à détruire
+*/
+void detruireSolution(Solution& s) {
+	delete[] s.coups;
+	s.coups = nullptr;
+	delete[] s.perdants;
+	s.perdants = nullptr;
+	s.nbNoeuds = 0;
+}
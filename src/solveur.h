@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef _SOLVEUR_
+#define _SOLVEUR_
+
+/**
+ * @file solveur.h
+ * @brief Entête du composant de résolution du jeu sur l'arbre des préfixes
+ */
+
+#include "dico.h"
+
+/**
+* @brief Résultat de la résolution pour un nombre de joueurs donné, par noeud de l'arbre des préfixes
+* @note Le joueur qui doit jouer au préfixe d'un noeud est dit gagnant si perdant[noeud] != 0
+*/
+struct Solution {
+	unsigned int nbJoueurs;
+	unsigned int nbNoeuds; // 0 si rien n'est résolu
+	char* coups; // Meilleur coup après le préfixe : une lettre, ou '?' pour contester le joueur précédent
+	unsigned char* perdants; // Joueur qui prend le quart de singe en jeu parfait, compté à partir de celui qui joue (0 = lui)
+};
+
+/**
+* @brief Résout le jeu : pour chaque préfixe, qui perd la manche et quelle lettre jouer
+* @param[out] s: La solution
+* @param[in] d: Le dictionnaire, dont l'arbre est construit
+* @param[in] nbJoueurs: Le nombre de joueurs de la partie, au plus UCHAR_MAX (rien n'est résolu au-delà)
+* @param[in] nbThreads: Le nombre de fils d'exécution à utiliser, 0 pour un par coeur
+* @see detruireSolution
+*/
+void resoudre(Solution& s, const Dico& d, unsigned int nbJoueurs, unsigned int nbThreads);
+/**
+* @brief Donne le coup à jouer après un préfixe
+* @param[in] s: La solution
+* @param[in] noeud: Le noeud du préfixe dans l'arbre
+* @return La lettre ou '?', '\0' si le préfixe n'est pas résolu
+*/
+char coupSolution(const Solution& s, unsigned int noeud);
+/**
+* @brief Libère la mémoire d'une solution
+* @param[in,out] s: La solution à détruire
+*/
+void detruireSolution(Solution& s);
+
+
+#endif // !_SOLVEUR_
@@ -0,0 +1,253 @@
+/**
+ * @file sortie.cpp
+ * @brief Composant sorties de la partie : console avec tampon, sortie nulle et lignes JSON
+ *
+ * La partie écrit par petits morceaux ; écrire chacun sur le flot et le forcer à chaque fin de ligne coûte
+ * bien plus cher que la partie elle-même dès que la sortie est un tube ou un fichier.
+ * Les sorties gardent le texte dans leur tampon et ne l'écrivent qu'en blocs, ou quand une saisie l'attend.
+ */
+
+#include <iostream>
+#include <cstring>
+
+#include "sortie.h"
+
+using namespace std;
+
+/**
+* @brief Écrit le tampon sur le flot, sans le forcer
+* @param[in,out] s: La sortie
+*/
+static void ecrireTampon(SortieFlot& s) {
+	if (s.taille > 0) s.flot->write(s.tampon, s.taille);
+	s.taille = 0;
+}
+/**
+* @brief Ajoute des octets au tampon, en l'écrivant quand il est plein
+* @param[in,out] s: La sortie
+* @param[in] texte: Les octets
+* @param[in] longueur: Le nombre d'octets
+*/
+static void remplirTampon(SortieFlot& s, const char* texte, unsigned int longueur) {
+	if (s.taille + longueur > TAILLE_TAMPON_SORTIE) {
+		ecrireTampon(s);
+		if (longueur > TAILLE_TAMPON_SORTIE) {
+			s.flot->write(texte, longueur);
+			return;
+		}
+	}
+	memcpy(s.tampon + s.taille, texte, longueur);
+	s.taille += longueur;
+}
+
+/**
+* @brief Console : ajoute le texte au tampon
+*/
+static void ajouterConsole(Sortie& s, const char* texte, unsigned int longueur) {
+	remplirTampon(*static_cast<SortieFlot*>(s.contexte), texte, longueur);
+}
+/**
+* @brief Console : termine la ligne par un retour à la ligne, sans forcer le flot comme le ferait endl
+*/
+static void terminerLigneConsole(Sortie& s) {
+	remplirTampon(*static_cast<SortieFlot*>(s.contexte), "\n", 1);
+}
+/**
+* @brief Console : écrit le tampon et force le flot
+*/
+static void viderConsole(Sortie& s) {
+	SortieFlot& f = *static_cast<SortieFlot*>(s.contexte);
+	ecrireTampon(f);
+	f.flot->flush();
+}
+
+/**
+* @brief Sortie nulle : ignore le texte
+*/
+static void ajouterRien(Sortie&, const char*, unsigned int) {
+}
+/**
+* @brief Sortie nulle : ignore la fin de ligne ou la demande de vider
+*/
+static void rien(Sortie&) {
+}
+
+/**
+* @brief JSON : ajoute le texte à la ligne en cours
+*/
+static void ajouterJson(Sortie& s, const char* texte, unsigned int longueur) {
+	SortieFlot& f = *static_cast<SortieFlot*>(s.contexte);
+	if (f.tailleLigne + longueur > TAILLE_LIGNE_SORTIE) longueur = TAILLE_LIGNE_SORTIE - f.tailleLigne;
+	memcpy(f.ligne + f.tailleLigne, texte, longueur);
+	f.tailleLigne += longueur;
+}
+/**
+* @brief JSON : écrit la ligne en cours comme un objet, puis la vide
+* @param[in,out] s: La sortie
+* @param[in] type: La valeur du champ type
+*/
+static void ecrireObjetJson(SortieFlot& s, const char* type) {
+	remplirTampon(s, "{\"type\":\"", 9);
+	remplirTampon(s, type, (unsigned int)strlen(type));
+	remplirTampon(s, "\",\"texte\":\"", 11);
+	for (unsigned int i = 0; i < s.tailleLigne; ++i) {
+		unsigned char c = (unsigned char)s.ligne[i];
+		char echappe[6];
+		if (c == '"' || c == '\\') {
+			echappe[0] = '\\';
+			echappe[1] = (char)c;
+			remplirTampon(s, echappe, 2);
+		}
+		else if (c < 0x20) {
+			const char* chiffres = "0123456789abcdef";
+			echappe[0] = '\\';
+			echappe[1] = 'u';
+			echappe[2] = '0';
+			echappe[3] = '0';
+			echappe[4] = chiffres[c >> 4];
+			echappe[5] = chiffres[c & 15];
+			remplirTampon(s, echappe, 6);
+		}
+		else if (c >= 0x80) {
+			// Les messages sont en Latin-1, JSON demande de l'UTF-8
+			echappe[0] = (char)(0xC0 | (c >> 6));
+			echappe[1] = (char)(0x80 | (c & 0x3F));
+			remplirTampon(s, echappe, 2);
+		}
+		else {
+			remplirTampon(s, s.ligne + i, 1);
+		}
+	}
+	remplirTampon(s, "\"}\n", 3);
+	s.tailleLigne = 0;
+}
+/**
+* @brief JSON : écrit la ligne terminée comme un message
+*/
+static void terminerLigneJson(Sortie& s) {
+	ecrireObjetJson(*static_cast<SortieFlot*>(s.contexte), "message");
+}
+/**
+* @brief JSON : écrit le texte non terminé comme une invite, puis le tampon, et force le flot
+*/
+static void viderJson(Sortie& s) {
+	SortieFlot& f = *static_cast<SortieFlot*>(s.contexte);
+	if (f.tailleLigne > 0) ecrireObjetJson(f, "invite");
+	ecrireTampon(f);
+	f.flot->flush();
+}
+
+/**
+* @brief Initialise une sortie qui écrit le texte tel quel, par blocs
+* @param[out] s: La sortie
+* @param[in,out] flot: Le flot où écrire
+*/
+void initialiserSortieConsole(SortieFlot& s, ostream& flot) {
+	s.sortie.ajouter = ajouterConsole;
+	s.sortie.terminerLigne = terminerLigneConsole;
+	s.sortie.vider = viderConsole;
+	s.sortie.contexte = &s;
+	s.flot = &flot;
+	s.taille = 0;
+	s.tailleLigne = 0;
+}
+/**
+* @brief Initialise une sortie qui ignore tout
+* @param[out] s: La sortie
+*/
+void initialiserSortieNulle(Sortie& s) {
+	s.ajouter = ajouterRien;
+	s.terminerLigne = rien;
+	s.vider = rien;
+	s.contexte = nullptr;
+}
+/**
+* @brief Initialise une sortie qui écrit chaque ligne comme un objet JSON, une ligne par objet
+* @param[out] s: La sortie
+* @param[in,out] flot: Le flot où écrire
+* @note Une ligne terminée donne {"type":"message","texte":...}, un texte non terminé au moment de vider
+* (l'invite d'une saisie) donne {"type":"invite","texte":...}. Le texte Latin-1 est écrit en UTF-8.
+*/
+void initialiserSortieJson(SortieFlot& s, ostream& flot) {
+	s.sortie.ajouter = ajouterJson;
+	s.sortie.terminerLigne = terminerLigneJson;
+	s.sortie.vider = viderJson;
+	s.sortie.contexte = &s;
+	s.flot = &flot;
+	s.taille = 0;
+	s.tailleLigne = 0;
+}
+/**
+* @brief Donne la sortie console du programme, sur cout
+* @return La sortie
+*/
+Sortie& sortieConsole() {
+	static SortieFlot console;
+	static bool initialisee = false;
+	if (!initialisee) {
+		initialiserSortieConsole(console, cout);
+		initialisee = true;
+	}
+	return console.sortie;
+}
+/**
+* @brief Écrit tout ce qui attend et force le flot, avant une saisie ou à la fin de la partie
+* @param[in,out] s: La sortie
+*/
+void viderSortie(Sortie& s) {
+	s.vider(s);
+}
+/**
+* @brief Termine la ligne en cours, sans forcer le flot
+* @param[in,out] s: La sortie
+* @return La sortie
+*/
+Sortie& finLigne(Sortie& s) {
+	s.terminerLigne(s);
+	return s;
+}
+/**
+* @brief Ajoute du texte à la ligne en cours
+* @param[in,out] s: La sortie
+* @param[in] texte: Le texte, terminé par '\0'
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, const char* texte) {
+	s.ajouter(s, texte, (unsigned int)strlen(texte));
+	return s;
+}
+/**
+* @brief Ajoute un caractère à la ligne en cours
+* @param[in,out] s: La sortie
+* @param[in] c: Le caractère
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, char c) {
+	s.ajouter(s, &c, 1);
+	return s;
+}
+/**
+* @brief Ajoute un entier à la ligne en cours
+* @param[in,out] s: La sortie
+* @param[in] n: L'entier
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, unsigned int n) {
+	char chiffres[10];
+	unsigned int i = sizeof(chiffres);
+	do {
+		chiffres[--i] = (char)('0' + n % 10);
+		n /= 10;
+	} while (n > 0);
+	s.ajouter(s, chiffres + i, sizeof(chiffres) - i);
+	return s;
+}
+/**
+* @brief Applique un manipulateur à la sortie, comme finLigne
+* @param[in,out] s: La sortie
+* @param[in] manipulateur: Le manipulateur
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, Sortie& (*manipulateur)(Sortie&)) {
+	return manipulateur(s);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#ifndef _SORTIE_
+#define _SORTIE_
+
+/**
+ * @file sortie.h
+ * @brief Entête du composant sorties de la partie : console avec tampon, sortie nulle et lignes JSON
+ */
+
+#include <iosfwd>
+
+ /**
+ * @brief Les constantes des sorties
+ */
+enum {
+	TAILLE_TAMPON_SORTIE = 4096, // Texte gardé avant d'être écrit sur le flot
+	TAILLE_LIGNE_SORTIE = 512, // Ligne la plus longue gardée par la sortie JSON, la suite est ignorée
+};
+
+/**
+* @brief Une sortie de la partie, dont le comportement est donné par ses trois opérations
+* @note Rien n'est forcé vers le flot avant un appel à viderSortie, qu'il faut faire avant chaque saisie
+*/
+struct Sortie {
+	void (*ajouter)(Sortie& s, const char* texte, unsigned int longueur); // Ajoute du texte à la ligne en cours
+	void (*terminerLigne)(Sortie& s);
+	void (*vider)(Sortie& s); // Écrit tout ce qui attend et force le flot
+	void* contexte; // Données de la sortie : sa SortieFlot, ou celles d'une sortie définie ailleurs comme la session du serveur
+};
+/**
+* @brief Une sortie console ou JSON, avec le flot où elle écrit et ses tampons
+* @note Sa sortie pointe sur elle : elle ne doit pas être copiée une fois initialisée
+*/
+struct SortieFlot {
+	Sortie sortie; // Celle que lit la partie
+	std::ostream* flot; // Où écrire
+	char tampon[TAILLE_TAMPON_SORTIE];
+	unsigned int taille;
+	char ligne[TAILLE_LIGNE_SORTIE]; // Ligne en cours de la sortie JSON
+	unsigned int tailleLigne;
+};
+
+/**
+* @brief Initialise une sortie qui écrit le texte tel quel, par blocs
+* @param[out] s: La sortie
+* @param[in,out] flot: Le flot où écrire
+*/
+void initialiserSortieConsole(SortieFlot& s, std::ostream& flot);
+/**
+* @brief Initialise une sortie qui ignore tout
+* @param[out] s: La sortie
+*/
+void initialiserSortieNulle(Sortie& s);
+/**
+* @brief Initialise une sortie qui écrit chaque ligne comme un objet JSON, une ligne par objet
+* @param[out] s: La sortie
+* @param[in,out] flot: Le flot où écrire
+* @note Une ligne terminée donne {"type":"message","texte":...}, un texte non terminé au moment de vider
+* (l'invite d'une saisie) donne {"type":"invite","texte":...}. Le texte Latin-1 est écrit en UTF-8.
+*/
+void initialiserSortieJson(SortieFlot& s, std::ostream& flot);
+/**
+* @brief Donne la sortie console du programme, sur cout
+* @return La sortie
+*/
+Sortie& sortieConsole();
+/**
+* @brief Écrit tout ce qui attend et force le flot, avant une saisie ou à la fin de la partie
+* @param[in,out] s: La sortie
+*/
+void viderSortie(Sortie& s);
+/**
+* @brief Termine la ligne en cours, sans forcer le flot
+* @param[in,out] s: La sortie
+* @return La sortie
+*/
+Sortie& finLigne(Sortie& s);
+
+/**
+* @brief Ajoute du texte à la ligne en cours
+* @param[in,out] s: La sortie
+* @param[in] texte: Le texte, terminé par '\0'
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, const char* texte);
+/**
+* @brief Ajoute un caractère à la ligne en cours
+* @param[in,out] s: La sortie
+* @param[in] c: Le caractère
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, char c);
+/**
+* @brief Ajoute un entier à la ligne en cours
+* @param[in,out] s: La sortie
+* @param[in] n: L'entier
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, unsigned int n);
+/**
+* @brief Applique un manipulateur à la sortie, comme finLigne
+* @param[in,out] s: La sortie
+* @param[in] manipulateur: Le manipulateur
+* @return La sortie
+*/
+Sortie& operator<<(Sortie& s, Sortie& (*manipulateur)(Sortie&));
+
+
+#endif // !_SORTIE_
@@ -0,0 +1,183 @@
+/**
+ * @file statistiques.cpp
+ * @brief Composant statistiques : compteurs et minuteurs des chemins chauds, affichés par --stats
+ *
+ * Chaque fil d'exécution compte dans ses propres compteurs, locaux au fil : pas de verrou ni d'opération atomique
+ * sur le chemin chaud, et pas d'allocation qui fausserait le compte des allocations d'une partie.
+ * Un fil qui se termine ajoute ses compteurs à ceux des fils finis, sous verrou ; l'affichage y ajoute ceux du fil
+ * appelant. Les fils d'un tournoi, du robot Monte-Carlo et du registre sont terminés avant l'affichage.
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+
+#include "statistiques.h"
+
+using namespace std;
+
+bool statistiquesActives = false;
+
+/**
+* @brief Les compteurs d'un fil d'exécution, ajoutés à ceux des fils finis quand il se termine
+*/
+struct CompteFil {
+	Statistiques s; // Initialisés à zéro
+	~CompteFil();
+};
+
+static Statistiques filsFinis; // Somme des compteurs des fils terminés
+static mutex verrou; // Protège filsFinis
+static thread_local CompteFil compteFil;
+static thread_local unsigned long long nbAllocationsFil = 0;
+
+/**
+* @brief Ajoute des compteurs à d'autres
+* @param[in,out] somme: Les compteurs à augmenter
+* @param[in] s: Les compteurs à ajouter
+*/
+static void cumulerStatistiques(Statistiques& somme, const Statistiques& s) {
+	somme.nbChargements += s.nbChargements;
+	somme.nsChargement += s.nsChargement;
+	somme.nbMotsCharges += s.nbMotsCharges;
+	somme.nbVerifications += s.nbVerifications;
+	somme.nbSondes += s.nbSondes;
+	for (unsigned int k = 0; k < NB_CLASSES_LATENCE; ++k) {
+		somme.coupsNormaux[k] += s.coupsNormaux[k];
+		somme.coupsInterrogation[k] += s.coupsInterrogation[k];
+		somme.coupsMonteCarlo[k] += s.coupsMonteCarlo[k];
+	}
+	somme.nsCoupsNormaux += s.nsCoupsNormaux;
+	somme.nsCoupsInterrogation += s.nsCoupsInterrogation;
+	somme.nsCoupsMonteCarlo += s.nsCoupsMonteCarlo;
+	somme.nbTirages += s.nbTirages;
+	somme.nbHorsSeuil += s.nbHorsSeuil;
+	somme.nbCoupsMonteCarlo += s.nbCoupsMonteCarlo;
+	somme.nbFinsMonteCarlo += s.nbFinsMonteCarlo;
+	somme.nbCoupsLivre += s.nbCoupsLivre;
+	somme.nbParties += s.nbParties;
+	somme.nbAllocations += s.nbAllocations;
+}
+/**
+* @brief Ajoute les compteurs du fil qui se termine à ceux des fils finis
+*/
+CompteFil::~CompteFil() {
+	lock_guard<mutex> garde(verrou);
+	cumulerStatistiques(filsFinis, s);
+}
+/**
+* @brief Donne les compteurs du fil d'exécution appelant
+* @return Les compteurs, sans allocation : ils sont locaux au fil
+*/
+Statistiques& statistiquesFil() {
+	return compteFil.s;
+}
+/**
+* @brief Donne l'heure en ns, pour les minuteurs
+* @return L'heure d'une horloge monotone
+*/
+unsigned long long horlogeNs() {
+	return (unsigned long long)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+/**
+* @brief Range une durée dans un histogramme de latences
+* @param[in,out] histogramme: Les NB_CLASSES_LATENCE classes
+* @param[in] ns: La durée
+*/
+void noterLatence(unsigned long long* histogramme, unsigned long long ns) {
+	unsigned int classe = 0;
+	while (ns > 1 && classe < NB_CLASSES_LATENCE - 1) {
+		ns >>= 1;
+		++classe;
+	}
+	++histogramme[classe];
+}
+/**
+* @brief Donne le nombre d'allocations faites par le fil d'exécution appelant
+* @return Le nombre d'allocations, 0 si le programme ne les compte pas
+* @see compterAllocation
+*/
+unsigned long long allocationsFil() {
+	return nbAllocationsFil;
+}
+/**
+* @brief Compte une allocation du fil d'exécution appelant, depuis un operator new du programme
+*/
+void compterAllocation() {
+	++nbAllocationsFil;
+}
+#if STATISTIQUES
+/**
+* @brief Affiche l'histogramme des durées d'un type de coup
+* @param[in,out] flot: Le flot où écrire
+* @param[in] nom: Le nom du type de coup
+* @param[in] histogramme: Les NB_CLASSES_LATENCE classes
+* @param[in] total: La somme des durées, en ns
+*/
+static void afficherLatences(ostream& flot, const char* nom, const unsigned long long* histogramme, unsigned long long total) {
+	unsigned long long nbCoups = 0;
+	for (unsigned int k = 0; k < NB_CLASSES_LATENCE; ++k) nbCoups += histogramme[k];
+	flot << nom << " : " << nbCoups << " coups";
+	if (nbCoups == 0) {
+		flot << "\n";
+		return;
+	}
+	flot << ", " << fixed << setprecision(0) << (double)total / nbCoups << " ns en moyenne\n";
+
+	// Les centiles sont donnés par la borne haute de leur classe
+	unsigned long long cumul = 0;
+	const double centiles[] = { 0.5, 0.9, 0.99, 1.0 };
+	const char* noms[] = { "p50", "p90", "p99", "max" };
+	unsigned int c = 0;
+	flot << " ";
+	for (unsigned int k = 0; k < NB_CLASSES_LATENCE && c < 4; ++k) {
+		cumul += histogramme[k];
+		while (c < 4 && cumul >= centiles[c] * nbCoups) {
+			flot << " " << noms[c] << " < " << (2ull << k) << " ns";
+			++c;
+		}
+	}
+	flot << "\n";
+	for (unsigned int k = 0; k < NB_CLASSES_LATENCE; ++k) {
+		if (histogramme[k] == 0) continue;
+		flot << "  [" << (1ull << k) << ", " << (2ull << k) << ") ns : " << histogramme[k] << "\n";
+	}
+}
+#endif
+/**
+* @brief Affiche la somme des compteurs des fils d'exécution terminés et du fil appelant
+* @param[in,out] flot: Le flot où écrire
+*/
+void afficherStatistiques(ostream& flot) {
+#if STATISTIQUES
+	Statistiques s = compteFil.s;
+	{
+		lock_guard<mutex> garde(verrou);
+		cumulerStatistiques(s, filsFinis);
+	}
+
+	unsigned long long nbCoupsNormaux = 0;
+	for (unsigned int k = 0; k < NB_CLASSES_LATENCE; ++k) nbCoupsNormaux += s.coupsNormaux[k];
+
+	flot << "--- statistiques ---\n";
+	flot << "dictionnaire : " << s.nbChargements << " chargements, " << s.nbMotsCharges << " mots, "
+		<< fixed << setprecision(1) << s.nsChargement / 1e6 << " ms\n";
+	flot << "estMotValide : " << s.nbVerifications << " appels, " << setprecision(2)
+		<< (s.nbVerifications > 0 ? (double)s.nbSondes / s.nbVerifications : 0.0) << " sondes par appel\n";
+	afficherLatences(flot, "casNormalSaisiR", s.coupsNormaux, s.nsCoupsNormaux);
+	afficherLatences(flot, "casPtInterroR", s.coupsInterrogation, s.nsCoupsInterrogation);
+	afficherLatences(flot, "casMonteCarloSaisiR", s.coupsMonteCarlo, s.nsCoupsMonteCarlo);
+	flot << "tirages par coup de casNormalSaisiR : " << setprecision(2)
+		<< (nbCoupsNormaux > 0 ? (double)s.nbTirages / nbCoupsNormaux : 0.0) << "\n";
+	flot << "coups plus longs que le seuil : " << s.nbHorsSeuil << "\n";
+	flot << "fins de manche par coup de coupMonteCarlo : " << setprecision(0)
+		<< (s.nbCoupsMonteCarlo > 0 ? (double)s.nbFinsMonteCarlo / s.nbCoupsMonteCarlo : 0.0) << "\n";
+	flot << "coups lus dans le livre d'ouvertures : " << s.nbCoupsLivre << "\n";
+	flot << "parties : " << s.nbParties << ", " << setprecision(2)
+		<< (s.nbParties > 0 ? (double)s.nbAllocations / s.nbParties : 0.0) << " allocations par partie\n";
+	flot.flush();
+#else
+	flot << "Statistiques non compilées : recompiler sans -DSTATISTIQUES=0" << endl;
+#endif
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#ifndef _STATISTIQUES_
+#define _STATISTIQUES_
+
+/**
+ * @file statistiques.h
+ * @brief Entête du composant statistiques : compteurs et minuteurs des chemins chauds, affichés par --stats
+ *
+ * Compiler avec -DSTATISTIQUES=0 retire tous les compteurs et minuteurs : les macros ci-dessous ne produisent plus rien.
+ */
+
+#include <iosfwd>
+
+#ifndef STATISTIQUES
+#define STATISTIQUES 1
+#endif
+
+ /**
+ * @brief Les constantes des statistiques
+ */
+enum {
+	NB_CLASSES_LATENCE = 32, // Classe k : durées de 2^k à 2^(k+1) - 1 ns
+};
+
+/**
+* @brief Les compteurs d'un fil d'exécution
+*/
+struct Statistiques {
+	unsigned long long nbChargements; // Dictionnaires chargés par ce fil
+	unsigned long long nsChargement;
+	unsigned long long nbMotsCharges;
+	unsigned long long nbVerifications; // Appels à estMotValide
+	unsigned long long nbSondes; // Cases de la table (ou pas de la dichotomie) lues par estMotValide
+	unsigned long long coupsNormaux[NB_CLASSES_LATENCE]; // Durées de casNormalSaisiR par classe
+	unsigned long long nsCoupsNormaux;
+	unsigned long long coupsInterrogation[NB_CLASSES_LATENCE]; // Durées de casPtInterroR par classe
+	unsigned long long nsCoupsInterrogation;
+	unsigned long long nbTirages; // Tirages au hasard de casNormalSaisiR
+	unsigned long long nbHorsSeuil; // Coups mesurés plus longs que le seuil de leur partie
+	unsigned long long coupsMonteCarlo[NB_CLASSES_LATENCE]; // Durées de casMonteCarloSaisiR par classe
+	unsigned long long nsCoupsMonteCarlo;
+	unsigned long long nbCoupsMonteCarlo; // Coups cherchés par coupMonteCarlo
+	unsigned long long nbFinsMonteCarlo; // Fins de manche jouées pour les choisir
+	unsigned long long nbCoupsLivre; // Coups du robot Monte-Carlo lus dans le livre d'ouvertures
+	unsigned long long nbParties; // Parties finies
+	unsigned long long nbAllocations; // Allocations faites pendant les parties
+};
+
+extern bool statistiquesActives; // Vrai avec --stats : les compteurs et les minuteurs ne comptent que si elle est vraie
+
+/**
+* @brief Donne les compteurs du fil d'exécution appelant
+* @return Les compteurs, sans allocation : ils sont locaux au fil
+*/
+Statistiques& statistiquesFil();
+/**
+* @brief Donne l'heure en ns, pour les minuteurs
+* @return L'heure d'une horloge monotone
+*/
+unsigned long long horlogeNs();
+/**
+* @brief Range une durée dans un histogramme de latences
+* @param[in,out] histogramme: Les NB_CLASSES_LATENCE classes
+* @param[in] ns: La durée
+*/
+void noterLatence(unsigned long long* histogramme, unsigned long long ns);
+/**
+* @brief Donne le nombre d'allocations faites par le fil d'exécution appelant
+* @return Le nombre d'allocations, 0 si le programme ne les compte pas
+* @see compterAllocation
+*/
+unsigned long long allocationsFil();
+/**
+* @brief Compte une allocation du fil d'exécution appelant, depuis un operator new du programme
+*/
+void compterAllocation();
+/**
+* @brief Affiche la somme des compteurs des fils d'exécution terminés et du fil appelant
+* @param[in,out] flot: Le flot où écrire
+*/
+void afficherStatistiques(std::ostream& flot);
+
+#if STATISTIQUES
+#define COMPTER(champ, n) (statistiquesActives ? (void)(statistiquesFil().champ += (n)) : (void)0)
+#define DEBUT_MESURE(debut) unsigned long long debut = statistiquesActives ? horlogeNs() : 0
+#define FIN_MESURE(debut, histogramme, total, seuil) \
+	if (statistiquesActives) { \
+		unsigned long long duree_ = horlogeNs() - (debut); \
+		noterLatence(statistiquesFil().histogramme, duree_); \
+		statistiquesFil().total += duree_; \
+		if ((seuil) > 0 && duree_ > (seuil)) ++statistiquesFil().nbHorsSeuil; \
+	}
+#define DEBUT_ALLOCATIONS(debut) unsigned long long debut = allocationsFil()
+#define FIN_ALLOCATIONS(debut) COMPTER(nbAllocations, allocationsFil() - (debut))
+#else
+#define COMPTER(champ, n) ((void)0)
+#define DEBUT_MESURE(debut) ((void)0)
+#define FIN_MESURE(debut, histogramme, total, seuil) ((void)0)
+#define DEBUT_ALLOCATIONS(debut) ((void)0)
+#define FIN_ALLOCATIONS(debut) ((void)0)
+#endif
+
+
+#endif // !_STATISTIQUES_
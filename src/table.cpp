@@ -0,0 +1,140 @@
+/**
+ * @file table.cpp
+ * @brief Composant table de hachage des mots, précédée d'un filtre de Bloom
+ *
+ * La plupart des mots vérifiés pendant une manche sont des préfixes qui ne sont pas des mots.
+ * Le filtre, d'une dizaine de bits par mot, tient dans le cache : il répond non en lisant une seule ligne de 64 octets.
+ * Les autres mots sont cherchés dans une table à adressage ouvert, dont chaque case garde 32 bits du hachage
+ * pour ne lire la zone des mots qu'en cas de probable égalité.
+ */
+
+#include <cstring>
+#include <new>
+
+#include "table.h"
+#include "statistiques.h"
+
+using namespace std;
+
+enum {
+	BITS_PAR_MOT = 10, // Taille du filtre
+	NB_SONDES = 6, // Bits du filtre posés par mot, tous dans le même bloc de 512 bits
+	MOTS_PAR_BLOC = TAILLE_BLOC_FILTRE / 8, // Entiers de 64 bits par bloc du filtre
+};
+
+/**
+* @brief Calcule le hachage d'un mot (FNV-1a de 64 bits, puis brassage des bits)
+* @param[in] mot: Le mot, terminé par un caractère vérifiant estFinMot
+* @return Le hachage
+*/
+static inline unsigned long long hacherMot(const char* mot) {
+	unsigned long long h = 14695981039346656037ull;
+	for (unsigned int i = 0; !estFinMot(mot[i]); ++i) {
+		h = (h ^ (unsigned char)mot[i]) * 1099511628211ull;
+	}
+	h ^= h >> 33;
+	h *= 0xFF51AFD7ED558CCDull;
+	h ^= h >> 33;
+	return h;
+}
+/**
+* @brief Donne un second hachage, pour choisir le bloc du filtre et la case de la table
+* @param[in] h: Le hachage du mot
+* @return Le second hachage
+*/
+static inline unsigned long long rehacher(unsigned long long h) {
+	h *= 0xC4CEB9FE1A85EC53ull;
+	h ^= h >> 33;
+	return h;
+}
+/**
+* @brief Vérifie si le filtre de Bloom laisse passer un hachage
+* @param[in] d: Le dictionnaire, dont le filtre est construit
+* @param[in] h: Le hachage du mot
+* @param[in] h2: Le second hachage du mot
+* @return Faux si le mot n'est sûrement pas dans le dictionnaire
+*/
+static inline bool filtrePasseHachage(const Dico& d, unsigned long long h, unsigned long long h2) {
+	const unsigned long long* bloc = d.filtre + (size_t)(h2 & (d.nbBlocs - 1)) * MOTS_PAR_BLOC;
+	bool passe = true;
+	for (unsigned int i = 0; i < NB_SONDES; ++i) {
+		unsigned int bit = (unsigned int)(h >> (9 * i)) & 511;
+		passe &= (bloc[bit >> 6] >> (bit & 63)) & 1;
+	}
+	return passe;
+}
+/**
+* @brief Construit le filtre de Bloom et la table de hachage des mots du dictionnaire
+* @param[in,out] d: Le dictionnaire chargé
+* @note Inutile pour un dictionnaire binaire : son filtre et sa table sont projetés avec les mots
+* @see detruireDico
+*/
+void construireTable(Dico& d) {
+	unsigned int nbBlocs = 1;
+	while ((unsigned long long)nbBlocs * MOTS_PAR_BLOC * 64 < (unsigned long long)d.nbMot * BITS_PAR_MOT) nbBlocs *= 2;
+	unsigned long long* filtre = static_cast<unsigned long long*>(::operator new[]((size_t)nbBlocs * MOTS_PAR_BLOC * sizeof(unsigned long long), align_val_t(ALIGNEMENT_CLES)));
+	memset(filtre, 0, (size_t)nbBlocs * MOTS_PAR_BLOC * sizeof(unsigned long long));
+
+	// Au moins deux cases par mot : les suites de cases occupées restent courtes
+	unsigned int capacite = 1;
+	while (capacite < 2 * d.nbMot) capacite *= 2;
+	unsigned int masqueTable = capacite - 1;
+	unsigned int* table = new unsigned int[2 * (size_t)capacite];
+	memset(table, 0, 2 * (size_t)capacite * sizeof(unsigned int));
+
+	for (unsigned int i = 0; i < d.nbMot; ++i) {
+		unsigned long long h = hacherMot(motDico(d, i));
+		unsigned long long h2 = rehacher(h);
+
+		unsigned long long* bloc = filtre + (size_t)(h2 & (nbBlocs - 1)) * MOTS_PAR_BLOC;
+		for (unsigned int j = 0; j < NB_SONDES; ++j) {
+			unsigned int bit = (unsigned int)(h >> (9 * j)) & 511;
+			bloc[bit >> 6] |= 1ull << (bit & 63);
+		}
+
+		// Une case vide a l'indice 0 : les mots sont rangés avec leur indice + 1
+		unsigned int c = (unsigned int)(h2 >> 32) & masqueTable;
+		while (table[2 * c + 1] != 0) c = (c + 1) & masqueTable;
+		table[2 * c] = (unsigned int)h;
+		table[2 * c + 1] = i + 1;
+	}
+
+	if (!d.tableProjetee) {
+		if (d.filtre != nullptr) ::operator delete[]((void*)d.filtre, align_val_t(ALIGNEMENT_CLES));
+		delete[] d.table;
+	}
+	d.filtre = filtre;
+	d.nbBlocs = nbBlocs;
+	d.table = table;
+	d.masqueTable = masqueTable;
+	d.tableProjetee = false;
+}
+/**
+* @brief Vérifie si le filtre de Bloom laisse passer un mot
+* @param[in] d: Le dictionnaire, dont la table est construite
+* @param[in] mot: Le mot, terminé par '\0'
+* @return Faux si le mot n'est sûrement pas dans le dictionnaire, vrai s'il peut y être
+*/
+bool filtrePasse(const Dico& d, const char* mot) {
+	unsigned long long h = hacherMot(mot);
+	return filtrePasseHachage(d, h, rehacher(h));
+}
+/**
+* @brief Vérifie si un mot est dans le dictionnaire : le filtre écarte presque tous les absents, la table décide pour les autres
+* @param[in] d: Le dictionnaire, dont la table est construite
+* @param[in] mot: Le mot à chercher, terminé par '\0'
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherTable(const Dico& d, const char* mot) {
+	unsigned long long h = hacherMot(mot);
+	unsigned long long h2 = rehacher(h);
+	if (!filtrePasseHachage(d, h, h2)) return false;
+
+	unsigned int c = (unsigned int)(h2 >> 32) & d.masqueTable;
+	while (d.table[2 * c + 1] != 0) {
+		COMPTER(nbSondes, 1);
+		if (d.table[2 * c] == (unsigned int)h && comparerMot(motDico(d, d.table[2 * c + 1] - 1), mot) == 0) return true;
+		c = (c + 1) & d.masqueTable;
+	}
+	return false;
+}
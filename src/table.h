@@ -0,0 +1,36 @@
+#pragma once
+
+#ifndef _TABLE_
+#define _TABLE_
+
+/**
+ * @file table.h
+ * @brief Entête du composant table de hachage des mots, précédée d'un filtre de Bloom
+ */
+
+#include "dico.h"
+
+/**
+* @brief Construit le filtre de Bloom et la table de hachage des mots du dictionnaire
+* @param[in,out] d: Le dictionnaire chargé
+* @note Inutile pour un dictionnaire binaire : son filtre et sa table sont projetés avec les mots
+* @see detruireDico
+*/
+void construireTable(Dico& d);
+/**
+* @brief Vérifie si un mot est dans le dictionnaire : le filtre écarte presque tous les absents, la table décide pour les autres
+* @param[in] d: Le dictionnaire, dont la table est construite
+* @param[in] mot: Le mot à chercher, terminé par '\0'
+* @return Vrai si le mot est dans le dictionnaire, faux sinon
+*/
+bool chercherTable(const Dico& d, const char* mot);
+/**
+* @brief Vérifie si le filtre de Bloom laisse passer un mot
+* @param[in] d: Le dictionnaire, dont la table est construite
+* @param[in] mot: Le mot, terminé par '\0'
+* @return Faux si le mot n'est sûrement pas dans le dictionnaire, vrai s'il peut y être
+*/
+bool filtrePasse(const Dico& d, const char* mot);
+
+
+#endif // !_TABLE_